@@ -141,6 +141,21 @@ cluster::Vector<T, D>::operator[](const size_t index) const
     return data_.at(index);
 }
 
+// raw access //
+
+template<typename T, size_t D>
+T*
+cluster::Vector<T, D>::data()
+{
+    return data_.data();
+}
+template<typename T, size_t D>
+const T*
+cluster::Vector<T, D>::data() const
+{
+    return data_.data();
+}
+
 // assignment //
 
 template<typename T, size_t D>
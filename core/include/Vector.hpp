@@ -51,6 +51,10 @@ namespace cluster
         NumericType& operator[](size_t index);
         NumericType  operator[](size_t index) const;
 
+        // raw access
+        NumericType*       data();
+        const NumericType* data() const;
+
         // assignment
         Vector<NumericType, Dimension>& operator= (const Vector<NumericType, Dimension>& rhs);
         Vector<NumericType, Dimension>& operator+=(const Vector<NumericType, Dimension>& rhs);
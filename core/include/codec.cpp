@@ -0,0 +1,209 @@
+/**
+ * @file codec.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Reduced-precision encodings of observations.
+ */
+
+
+#include "codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace cluster
+{
+    namespace codec
+    {
+        namespace detail
+        {
+            inline std::uint32_t to_bits(const float value)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+            inline float from_bits(const std::uint32_t bits)
+            {
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+        }
+    }
+}
+
+
+template<size_t D>
+void
+cluster::codec::BFloat16<D>::
+fit(const Vector<float, D>*, size_t) {}
+template<size_t D>
+void
+cluster::codec::BFloat16<D>::
+encode(const Vector<float, D>& obs, Code* codes) const
+{
+    const float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        codes[d] = encode(values[d]);
+    }
+}
+template<size_t D>
+typename cluster::codec::BFloat16<D>::Code
+cluster::codec::BFloat16<D>::
+encode(const float value)
+{
+    std::uint32_t bits = detail::to_bits(value);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+    {
+        // keeps NaN a NaN once truncated
+        return static_cast<Code>((bits >> 16) | 0x40u);
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return static_cast<Code>(bits >> 16);
+}
+template<size_t D>
+void
+cluster::codec::BFloat16<D>::
+decode(const Code* codes, Vector<float, D>& obs) const
+{
+    float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        values[d] = detail::from_bits(static_cast<std::uint32_t>(codes[d]) << 16);
+    }
+}
+
+template<size_t D>
+void
+cluster::codec::Half<D>::
+fit(const Vector<float, D>*, size_t) {}
+template<size_t D>
+void
+cluster::codec::Half<D>::
+encode(const Vector<float, D>& obs, Code* codes) const
+{
+    const float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        codes[d] = encode(values[d]);
+    }
+}
+template<size_t D>
+typename cluster::codec::Half<D>::Code
+cluster::codec::Half<D>::
+encode(const float value)
+{
+    const std::uint32_t infinity = 0xFFu << 23,
+                        overflow = (127u + 16u) << 23,
+                        smallest_normal = 113u << 23,
+                        subnormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    std::uint32_t bits = detail::to_bits(value);
+    const std::uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    std::uint32_t code;
+    if (bits >= overflow)
+    {
+        code = bits > infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (bits < smallest_normal)
+    {
+        // float addition rounds the mantissa into place
+        const float rounded = detail::from_bits(bits) + detail::from_bits(subnormal_magic);
+        code = detail::to_bits(rounded) - subnormal_magic;
+    }
+    else
+    {
+        const std::uint32_t is_mantissa_odd = (bits >> 13) & 1u;
+        bits -= (127u - 15u) << 23;
+        bits += 0xFFFu + is_mantissa_odd;
+        code = bits >> 13;
+    }
+    return static_cast<Code>(code | (sign >> 16));
+}
+template<size_t D>
+void
+cluster::codec::Half<D>::
+decode(const Code* codes, Vector<float, D>& obs) const
+{
+    // shifted into a float's mantissa and exponent, a half is 2^-112 times 
+    // its value, for normals and subnormals alike
+    const float exponent_adjustment = 5.192296858534828e33f;  // 2^112
+    const std::uint32_t infinity = 0x7C00u << 13;
+
+    float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        const std::uint32_t code = codes[d],
+                            magnitude = (code & 0x7FFFu) << 13;
+        const std::uint32_t bits = 
+            detail::to_bits(detail::from_bits(magnitude) * exponent_adjustment) |
+            (magnitude >= infinity ? 0x7F800000u : 0u) |
+            ((code & 0x8000u) << 16);
+        values[d] = detail::from_bits(bits);
+    }
+}
+
+template<size_t D>
+cluster::codec::Int8<D>::
+Int8()
+{
+    offsets_.fill(0.0f);
+    scales_.fill(1.0f);
+}
+template<size_t D>
+void
+cluster::codec::Int8<D>::
+fit(const Vector<float, D>* observations, const size_t n)
+{
+    if (n == 0) { return; }
+    for (size_t d = 0; d < D; ++d)
+    {
+        float min = observations[0][d],
+              max = observations[0][d];
+        for (size_t i = 1; i < n; ++i)
+        {
+            min = std::min(min, observations[i][d]);
+            max = std::max(max, observations[i][d]);
+        }
+        offsets_[d] = min + (max - min) / 2;
+        scales_[d] = max > min ? (max - min) / 254 : 1.0f;
+    }
+}
+template<size_t D>
+void
+cluster::codec::Int8<D>::
+encode(const Vector<float, D>& obs, Code* codes) const
+{
+    const float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        codes[d] = encode(values[d], d);
+    }
+}
+template<size_t D>
+typename cluster::codec::Int8<D>::Code
+cluster::codec::Int8<D>::
+encode(const float value, const size_t dimension) const
+{
+    const float level = std::round((value - offsets_[dimension]) / scales_[dimension]);
+    if (std::isnan(level)) { return 0; }
+    return static_cast<Code>(std::max(-127.0f, std::min(127.0f, level)));
+}
+template<size_t D>
+void
+cluster::codec::Int8<D>::
+decode(const Code* codes, Vector<float, D>& obs) const
+{
+    float* values = obs.data();
+    for (size_t d = 0; d < D; ++d)
+    {
+        values[d] = offsets_[d] + codes[d] * scales_[d];
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef K_MEANS_CODEC_H
+#define K_MEANS_CODEC_H
+/**
+ * @file codec.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Reduced-precision encodings of observations.
+ */
+
+
+#include "Vector.hpp"
+
+#include <array>
+#include <cstdint>
+
+
+namespace cluster
+{
+    /**
+     * Container for encodings of single-precision observations into fewer
+     * bits.
+     *
+     * @details
+     *  A codec encodes each value of an observation as a Code. Codecs share
+     *  the interface:
+     *
+     *   typedef ... Code;
+     *   void fit(const Vector<float, Dimension>* observations, size_t n);
+     *   void encode(const Vector<float, Dimension>& observation, Code* codes) const;
+     *   void decode(const Code* codes, Vector<float, Dimension>& observation) const;
+     *
+     *  fit() is called once, with all observations, before any encoding. 
+     *  Whole observations are decoded at once, in loops without branches, 
+     *  so that compilers vectorize them.
+     */
+    namespace codec
+    {
+        /**
+         * Encodes values as bfloat16: the upper half of a float, rounded to
+         * nearest even. Keeps the range of float, with 8 bits of precision.
+         */
+        template<size_t Dimension>
+        class BFloat16
+        {
+            public:
+            typedef std::uint16_t Code;
+
+            void fit(const Vector<float, Dimension>* observations, size_t n);
+            void encode(const Vector<float, Dimension>& observation, Code* codes) const;
+            void decode(const Code* codes, Vector<float, Dimension>& observation) const;
+
+            private:
+            static Code encode(float value);
+        };
+
+        /**
+         * Encodes values as IEEE 754 half precision, rounded to nearest even.
+         * Keeps 11 bits of precision, for magnitudes up to 65504.
+         */
+        template<size_t Dimension>
+        class Half
+        {
+            public:
+            typedef std::uint16_t Code;
+
+            void fit(const Vector<float, Dimension>* observations, size_t n);
+            void encode(const Vector<float, Dimension>& observation, Code* codes) const;
+            void decode(const Code* codes, Vector<float, Dimension>& observation) const;
+
+            private:
+            static Code encode(float value);
+        };
+
+        /**
+         * Quantizes values to 8 bits, spread uniformly over each
+         * dimension's range in the fitted observations.
+         *
+         * @details
+         *  A value is decoded as offset + code * scale, with offset and
+         *  scale chosen per dimension, so that the range maps to codes
+         *  [-127, 127]. Values outside the range are clamped.
+         */
+        template<size_t Dimension>
+        class Int8
+        {
+            public:
+            typedef std::int8_t Code;
+
+            Int8();
+
+            void fit(const Vector<float, Dimension>* observations, size_t n);
+            void encode(const Vector<float, Dimension>& observation, Code* codes) const;
+            void decode(const Code* codes, Vector<float, Dimension>& observation) const;
+
+            private:
+            Code encode(float value, size_t dimension) const;
+
+            std::array<float, Dimension> offsets_;
+            std::array<float, Dimension> scales_;
+        };
+    }
+}
+
+
+#include "codec.cpp"
+
+
+#endif  // K_MEANS_CODEC_H
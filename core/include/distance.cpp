@@ -11,28 +11,35 @@
 
 
 template<typename T, size_t D>
-float cluster::distance::euclidean2<T, D>(
-
+float cluster::distance::euclidean2
+(
     const Vector<T, D>& a, const Vector<T, D>& b
 )
 {
-    float dot = 0;
-    for (size_t i = 0; i < D; ++i)
-    {
-        dot += (a[i] - b[i]) * (a[i] - b[i]);
-    }
-    return dot;
+    return simd::euclidean2(a.data(), b.data(), D);
 }
 template<typename T, size_t D>
-float cluster::distance::manhattan<T, D>(
-
+float cluster::distance::manhattan
+(
     const Vector<T, D>& a, const Vector<T, D>& b
 )
 {
-    float sum = 0;
-    for (size_t i = 0; i < D; ++i)
-    {
-        sum += std::abs(a[i] - b[i]);
-    }
-    return sum;
+    return simd::manhattan(a.data(), b.data(), D);
+}
+
+template<typename T>
+float cluster::distance::euclidean2
+(
+    const T* a, const T* b, const size_t dimension
+)
+{
+    return simd::euclidean2(a, b, dimension);
+}
+template<typename T>
+float cluster::distance::manhattan
+(
+    const T* a, const T* b, const size_t dimension
+)
+{
+    return simd::manhattan(a, b, dimension);
 }
@@ -9,8 +9,11 @@
  */
 
 
+#include "simd.hpp"
 #include "Vector.hpp"
 
+#include <type_traits>
+
 
 namespace cluster 
 { 
@@ -23,6 +26,16 @@ namespace cluster
     template<typename NumericType, size_t Dimension>
     using DistanceFunction = float (*) (const Vector<NumericType, Dimension>& a, 
                                         const Vector<NumericType, Dimension>& b);
+    /*
+     * Distance function signature for observations whose dimension is known 
+     * only at run time.
+     *
+     * @tparam NumericType Data type.
+     */
+    template<typename NumericType>
+    using DynamicDistanceFunction = float (*) (const NumericType* a, 
+                                               const NumericType* b, 
+                                               size_t dimension);
 
     /**
      * Container namespace for common distance functions.
@@ -32,6 +45,10 @@ namespace cluster
         /**
          * Computes Euclidean distance squared.
          *
+         * @details 
+         *  Single-precision vectors of dimension simd::MIN_DIMENSION or more
+         *  use the vectorized kernels of simd.
+         *
          * @see DistanceFunction
          */
         template<typename NumericType, size_t Dimension>
@@ -40,11 +57,75 @@ namespace cluster
         /**
          * Computes Manhattan distance.
          *
+         * @details 
+         *  Single-precision vectors of dimension simd::MIN_DIMENSION or more
+         *  use the vectorized kernels of simd.
+         *
          * @see DistanceFunction
          */
         template<typename NumericType, size_t Dimension>
         float manhattan(const Vector<NumericType, Dimension>& a, 
                         const Vector<NumericType, Dimension>& b);
+
+        /**
+         * Computes Euclidean distance squared between arrays.
+         *
+         * @see DynamicDistanceFunction
+         */
+        template<typename NumericType>
+        float euclidean2(const NumericType* a, const NumericType* b, 
+                         size_t dimension);
+        /**
+         * Computes Manhattan distance between arrays.
+         *
+         * @see DynamicDistanceFunction
+         */
+        template<typename NumericType>
+        float manhattan(const NumericType* a, const NumericType* b, 
+                        size_t dimension);
+
+        namespace detail
+        {
+            /**
+             * Matches distance functions by template argument.
+             *
+             * @details
+             *  Unlike comparing function pointers in a constant expression, 
+             *  this compiles under any instrumentation, and does not rely on 
+             *  distinct functions keeping distinct addresses.
+             */
+            template<typename NumericType, size_t Dimension>
+            struct Identity
+            {
+                template<DistanceFunction<NumericType, Dimension> Distance, typename = void>
+                struct IsEuclidean2 : std::false_type {};
+                template<typename Unused>
+                struct IsEuclidean2<&euclidean2<NumericType, Dimension>, Unused> : 
+                    std::true_type {};
+
+                template<DistanceFunction<NumericType, Dimension> Distance, typename = void>
+                struct IsManhattan : std::false_type {};
+                template<typename Unused>
+                struct IsManhattan<&manhattan<NumericType, Dimension>, Unused> : 
+                    std::true_type {};
+            };
+        }
+        /**
+         * Checks at compile time whether Distance is euclidean2(), as 
+         * std::true_type or std::false_type.
+         */
+        template<typename NumericType, size_t Dimension, 
+                 DistanceFunction<NumericType, Dimension> Distance>
+        using is_euclidean2 = typename detail::Identity<NumericType, Dimension>::
+                              template IsEuclidean2<Distance>;
+        /**
+         * Checks at compile time whether Distance is manhattan(), as 
+         * std::true_type or std::false_type.
+         */
+        template<typename NumericType, size_t Dimension, 
+                 DistanceFunction<NumericType, Dimension> Distance>
+        using is_manhattan = typename detail::Identity<NumericType, Dimension>::
+                             template IsManhattan<Distance>;
     }
 }
 
@@ -9,6 +9,10 @@
 
 #include "kMeans.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
 cluster::kMeans<T, D, Distance>::
@@ -17,100 +21,213 @@ kMeans
     size_t k,
     const Vector<T, D>* obs, size_t n
 ) : 
-    observations_(obs, &obs[n]),
-    assigned_clusters_(n, 0),
+    kMeansBase<Sums>(k, n, k),
+    owned_observations_(obs, &obs[n]),
+    borrowed_observations_(nullptr),
+    mean_observations_(k),
+    mean_norms_(k, 0) {}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+cluster::kMeans<T, D, Distance>::
+kMeans
+(
+    size_t k,
+    const Vector<T, D>* obs, size_t n,
+    BorrowTag
+) : 
+    kMeansBase<Sums>(k, n, k),
+    borrowed_observations_(obs),
     mean_observations_(k),
-    cluster_sizes_(k) {}
+    mean_norms_(k, 0) {}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+cluster::kMeans<T, D, Distance>::
+kMeans
+(
+    size_t k,
+    std::vector<Vector<T, D>>&& obs
+) : 
+    kMeansBase<Sums>(k, obs.size(), k),
+    owned_observations_(std::move(obs)),
+    borrowed_observations_(nullptr),
+    mean_observations_(k),
+    mean_norms_(k, 0) {}
 
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
 void 
 cluster::kMeans<T, D, Distance>::
 initialize(const Vector<T, D>* means)
 {
-    for (size_t i = 0; i < k(); ++i)
+    for (size_t i = 0; i < this->k(); ++i)
+    {
+        set_mean(i, means[i]);
+    }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeans<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
     {
-        mean_observations_.at(i) = means[i];
+        float nearest_mean_distance;
+        const size_t nearest_mean_index = nearest_mean(observation(i), 
+                                                       nearest_mean_distance);
+        if (this->assigned_clusters_.at(i) != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_.at(i) = nearest_mean_index;
+        this->distances_[i] = nearest_mean_distance;
+        sizes.at(nearest_mean_index) += this->weight(i);
     }
+    return reassigned_count;
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-bool 
+size_t 
 cluster::kMeans<T, D, Distance>::
-assign()
+nearest_mean(const Vector<T, D>& obs, float& distance) const
 {
-    std::fill_n(cluster_sizes_.begin(), k(), 0);
-    bool is_converged = true;
-    for (size_t i = 0; i < n(); ++i)
+    size_t nearest_mean_index = 0;
+    float nearest_mean_distance = Distance(obs, mean(0));
+    for (size_t j = 1; j < this->k(); ++j)
     {
-        const Vector<T, D>& obs = observation(i);
-        size_t nearest_mean_index = 0;
-        float nearest_mean_distance = Distance(obs, mean(0));
-        for (size_t j = 1; j < k(); ++j)
+        const float distance_to_j = Distance(obs, mean(j));
+        if (distance_to_j < nearest_mean_distance)
         {
-            const float distance_to_j = Distance(obs, mean(j));
-            if (distance_to_j < nearest_mean_distance)
-            {
-                nearest_mean_index = j;
-                nearest_mean_distance = distance_to_j;
-            }
+            nearest_mean_index = j;
+            nearest_mean_distance = distance_to_j;
         }
-        is_converged = is_converged && assigned_clusters_.at(i) == nearest_mean_index;
-        assigned_clusters_.at(i) = nearest_mean_index;
-        ++ cluster_sizes_.at(nearest_mean_index);
     }
-    return !is_converged;
+    distance = nearest_mean_distance;
+    return nearest_mean_index;
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
 void
 cluster::kMeans<T, D, Distance>::
-update()
+update_range(const size_t begin, const size_t end, std::vector<Vector<T, D>>& sums) const
 {
-    std::vector<Vector<T, D>> new_means(k());
-    
-    for (size_t i = 0; i < n(); ++i)
+    for (size_t i = begin; i < end; ++i)
     {
-        const Vector<T, D>& obs = observation(i);
-        const size_t cls = cluster(i);
-        new_means.at(cls) += obs;
+        add_weighted(i, sums.at(this->cluster(i)));
     }
-    for (size_t i = 0; i < k(); ++i)
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeans<T, D, Distance>::
+set_mean_from_sums(const size_t index, const Sums& sums)
+{
+    Vector<T, D> sum = sums[index];
+    set_mean(index, sum.scale(1.0f / static_cast<float>(this->cluster_size(index))));
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeans<T, D, Distance>::
+set_mean_to_observation(const size_t index, const size_t observation_index)
+{
+    set_mean(index, observation(observation_index));
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeans<T, D, Distance>::
+set_mean(const size_t index, const Vector<T, D>& mean)
+{
+    this->mean_shift_ = std::max(this->mean_shift_, 
+                                 Distance(mean_observations_.at(index), mean));
+    mean_observations_.at(index) = mean;
+    mean_norms_.at(index) = squared_norm(mean);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+double
+cluster::kMeans<T, D, Distance>::
+weighted_norm(const size_t index) const
+{
+    const Vector<T, D>& obs = observation(index);
+    double norm = 0;
+    for (size_t d = 0; d < D; ++d)
     {
-        mean_observations_.at(i) = new_means.at(i).scale(1.0f / cluster_size(i));
+        norm += static_cast<double>(obs[d]) * obs[d];
     }
+    return this->weight(index) * norm;
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-size_t
+double
 cluster::kMeans<T, D, Distance>::
-run(const size_t max_iterations)
+expanded_inertia
+(
+    const double norm_sum, const Vector<T, D>& sum,
+    const double weight, const Vector<T, D>& point
+)
 {
-    size_t i = 0;
-    while (i < max_iterations && assign())
+    double inertia = norm_sum;
+    for (size_t d = 0; d < D; ++d)
     {
-        update();
-        ++ i;
+        const double value = point[d];
+        inertia += value * (weight * value - 2 * static_cast<double>(sum[d]));
     }
-    return i;
+    return inertia;
 }
-
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-const cluster::Vector<T, D>& 
+void
 cluster::kMeans<T, D, Distance>::
-observation(const size_t index) const
+cache_observation_norms()
 {
-    return observations_.at(index);
+    observation_norms_.resize(this->n());
+    for (size_t i = 0; i < this->n(); ++i)
+    {
+        observation_norms_[i] = squared_norm(observation(i));
+    }
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-size_t 
+void
 cluster::kMeans<T, D, Distance>::
-cluster(const size_t index) const
+compute_distances()
 {
-    return assigned_clusters_.at(index);
+    const size_t workers = parallel::worker_count(this->n(), this->thread_count_);
+    parallel::for_each_range
+    (
+        this->n(), workers,
+        [this](size_t, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                this->distances_[i] = Distance(observation(i),
+                                               mean_observations_[this->assigned_clusters_[i]]);
+            }
+        }
+    );
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-size_t 
+float
+cluster::kMeans<T, D, Distance>::
+squared_norm(const Vector<T, D>& vector)
+{
+    const T* values = vector.data();
+    float norm = 0;
+    for (size_t d = 0; d < D; ++d)
+    {
+        norm += values[d] * values[d];
+    }
+    return norm;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeans<T, D, Distance>::
+add_weighted(const size_t index, Vector<T, D>& sum) const
+{
+    // unweighted sums stay exact for integral data
+    if (this->weights_.empty()) { sum += observation(index); }
+    else { sum += Vector<T, D>(observation(index)).scale(this->weights_[index]); }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+const cluster::Vector<T, D>& 
 cluster::kMeans<T, D, Distance>::
-cluster_size(const size_t index) const
+observation(const size_t index) const
 {
-    return cluster_sizes_.at(index);
+    if (index >= this->observation_count_) 
+    { 
+        throw std::out_of_range("observation index out of range"); 
+    }
+    // owned storage is looked up on every access, so copies stay valid
+    return borrowed_observations_ != nullptr ? 
+           borrowed_observations_[index] : 
+           owned_observations_[index];
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
 const cluster::Vector<T, D>&
@@ -119,18 +236,18 @@ mean(const size_t index) const
 {
     return mean_observations_.at(index);
 }
-
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-size_t 
+float
 cluster::kMeans<T, D, Distance>::
-n() const
+observation_norm(const size_t index) const
 {
-    return observations_.size();
+    if (observation_norms_.empty()) { return squared_norm(observation(index)); }
+    return observation_norms_.at(index);
 }
 template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
-size_t 
+float
 cluster::kMeans<T, D, Distance>::
-k() const
+mean_norm(const size_t index) const
 {
-    return mean_observations_.size();
+    return mean_norms_.at(index);
 }
@@ -10,6 +10,7 @@
 
 
 #include "distance.hpp"
+#include "kMeansBase.hpp"
 #include "seeder.hpp"
 #include "Vector.hpp"
 
@@ -21,6 +22,8 @@ namespace cluster
 {   
     /**
      * The main class of the module. Computes a customizable k-means clustering.
+     *
+     * @details Observations and means are Vectors of a fixed dimension.
      * 
      * @tparam NumericType Data type.
      * @tparam Dimension   Data dimension.
@@ -31,7 +34,7 @@ namespace cluster
         size_t Dimension,
         DistanceFunction<NumericType, Dimension> Distance
     >
-    class kMeans
+    class kMeans : public kMeansBase<std::vector<Vector<NumericType, Dimension>>>
     {
         static_assert(std::is_arithmetic<NumericType>::value, 
                       "arithmetic type required");
@@ -47,6 +50,31 @@ namespace cluster
          */
         kMeans(size_t k,
                const Vector<NumericType, Dimension>* observations, size_t n);
+        /**
+         * Initialize a new instance over a borrowed observation sequence.
+         *
+         * @details Observations are not copied.
+         *
+         * @param k            Number of clusters.
+         * @param observations Pointer to first observation in sequence.
+         * @param n            Number of observations in sequence.
+         *
+         * @pre Sequence outlives the instance and is not modified while in use.
+         */
+        kMeans(size_t k,
+               const Vector<NumericType, Dimension>* observations, size_t n,
+               BorrowTag);
+        /**
+         * Initialize a new instance that adopts an observation container.
+         *
+         * @details The container's storage is moved in, not copied.
+         *
+         * @param k            Number of clusters.
+         * @param observations Observations.
+         */
+        kMeans(size_t k,
+               std::vector<Vector<NumericType, Dimension>>&& observations);
+        virtual ~kMeans() {}
 
         /**
          * Sets initial means from a sequence.
@@ -55,79 +83,128 @@ namespace cluster
          *
          * @pre Sequence has length >= number of clusters provided in constructor.
          */
-        void initialize(const Vector<NumericType, Dimension>* means);
-        
+        virtual void initialize(const Vector<NumericType, Dimension>* means);
+
         /**
-         * Assign observations to clusters.
-         * 
+         * Gets observation at index.
+         *
+         * @pre index is in [0, #(observations)).
+         */
+        const Vector<NumericType, Dimension>& observation(size_t index) const;
+        /**
+         * Gets mean observation of cluster at index.
+         *
+         * @pre index is in [0, k).
+         */
+        const Vector<NumericType, Dimension>& mean(size_t index) const;
+        /**
+         * Gets squared Euclidean norm of observation at index.
+         *
          * @details 
-         *  After a call to assign(), the assigned clusters can be
-         *  inspected through a call to cluster(size_t observation_index).
+         *  For kernels that expand squared Euclidean distances as 
+         *  |x|^2 - 2 x.c + |c|^2. Computed on every call, unless cached by 
+         *  cache_observation_norms().
          *
-         * @returns True if there was change in cluster assignment.
+         * @pre index is in [0, #(observations)).
          */
-        bool assign();
-
+        float observation_norm(size_t index) const;
         /**
-         * Update cluster means based on current observation-cluster assignment.
+         * Gets squared Euclidean norm of mean of cluster at index.
+         *
+         * @details Computed once whenever the mean changes.
          *
-         * @details
-         *  After a call to update(), the updated means can be 
-         *  inspected through a call to mean(size_t cluster_index). 
+         * @pre index is in [0, k).
          */
-        void update();
+        float mean_norm(size_t index) const;
+
+        protected:
+        typedef std::vector<Vector<NumericType, Dimension>> Sums;
 
         /**
-         * Repeats the assignment and update steps until termination condition is met, or 
-         * maximum number of iterations have been performed.
-         * 
-         * @param max_iterations Maximum number of iterations to perform.
+         * Sets mean of cluster at index, and its norm.
          *
-         * @return Number of iterations until termination.
+         * @details Derived classes change means only through this.
          */
-        size_t run(size_t max_iterations);
-
+        void set_mean(size_t index, const Vector<NumericType, Dimension>& mean);
         /**
-         * Gets number of observations.
+         * Finds the mean nearest to an observation.
+         *
+         * @details Ties are broken towards the lower index.
+         *
+         * @param distance Receives the distance to the nearest mean.
+         *
+         * @returns Index of the nearest mean.
          */
-        size_t n() const;
+        size_t nearest_mean(const Vector<NumericType, Dimension>& observation, 
+                            float& distance) const;
         /**
-         * Gets number of clusters.
+         * @see kMeansBase::assign_range
          */
-        size_t k() const;
-
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
         /**
-         * Gets observation at index.
-         *
-         * @pre index is in [0, #(observations)).
+         * @see kMeansBase::update_range
          */
-        const Vector<NumericType, Dimension>& observation(size_t index) const;
+        void update_range(size_t begin, size_t end, Sums& sums) const override;
+        /**
+         * @see kMeansBase::set_mean_from_sums
+         */
+        void set_mean_from_sums(size_t index, const Sums& sums) override;
+        /**
+         * @see kMeansBase::set_mean_to_observation
+         */
+        void set_mean_to_observation(size_t index, size_t observation_index) override;
         /**
-         * Gets cluster index of observation at index.
+         * Adds observation at index, times its weight, to a sum.
+         */
+        void add_weighted(size_t index, Vector<NumericType, Dimension>& sum) const;
+        /**
+         * Gets the squared Euclidean norm of observation at index times its 
+         * weight, in double precision.
+         */
+        double weighted_norm(size_t index) const;
+        /**
+         * Gets the weighted sum of distance::euclidean2 from a group of 
+         * observations to a point.
          *
-         * @pre index is in [0, #(observations)).
+         * @details 
+         *  Expands |x - c|^2 as |x|^2 - 2 x.c + |c|^2, so that it takes no 
+         *  pass over the group. Cancellation may leave the result of a 
+         *  tight group slightly negative.
          *
-         * @note Default value for unassigned observations is cluster zero.
+         * @param norm_sum Weighted sum of squared norms of the group, 
+         *                 @see weighted_norm.
+         * @param sum      Weighted sum of the group.
+         * @param weight   Total weight of the group.
          */
-        size_t cluster(size_t index) const;
+        static double expanded_inertia(double norm_sum, 
+                                       const Vector<NumericType, Dimension>& sum,
+                                       double weight, 
+                                       const Vector<NumericType, Dimension>& point);
         /**
-         * Gets the number of observations assigned to cluster at index.
+         * Computes the norms of all observations once, for observation_norm().
          *
-         * @pre index is in [0, k).
+         * @details Called by the constructors of engines that read them.
          */
-        size_t cluster_size(size_t index) const;
+        void cache_observation_norms();
         /**
-         * Gets mean observation of cluster at index.
+         * Sets distances_ to the exact distance of each observation to its
+         * assigned mean, with one distance per observation.
          *
-         * @pre index is in [0, k).
+         * @details For engines that keep bounds in distances_.
          */
-        const Vector<NumericType, Dimension>& mean(size_t index) const;
+        void compute_distances();
 
-        private:
-        std::vector<Vector<NumericType, Dimension>> observations_;
+        std::vector<Vector<NumericType, Dimension>> owned_observations_;
+        const Vector<NumericType, Dimension>* borrowed_observations_;
         std::vector<Vector<NumericType, Dimension>> mean_observations_;
-        std::vector<size_t> assigned_clusters_;
-        std::vector<size_t> cluster_sizes_;
+        std::vector<float> observation_norms_;  // empty unless cached
+        std::vector<float> mean_norms_;
+
+        private:
+        /**
+         * Computes squared Euclidean norm of a vector.
+         */
+        static float squared_norm(const Vector<NumericType, Dimension>& vector);
     };
  }
 
@@ -0,0 +1,425 @@
+/**
+ * @file kMeansBase.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBase.
+ */
+
+
+#include "kMeansBase.hpp"
+
+#include <algorithm>
+#include <limits>
+
+
+template<typename Sums>
+cluster::kMeansBase<Sums>::
+kMeansBase(const size_t k, const size_t n, const size_t sum_length) :
+    observation_count_(n),
+    assigned_clusters_(n, 0),
+    cluster_sizes_(k),
+    thread_count_(1),
+    distances_(n, 0),
+    reassigned_count_(0),
+    inertia_(0),
+    mean_shift_(0),
+    shift_tolerance_(0),
+    inertia_tolerance_(0),
+    reassignment_tolerance_(0),
+    empty_cluster_policy_(EmptyClusterPolicy::farthest),
+    sum_length_(sum_length),
+    sums_(sum_length),
+    is_sums_current_(false) {}
+
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_weights(const float* weights)
+{
+    if (weights == nullptr) { weights_.clear(); }
+    else { weights_.assign(weights, weights + n()); }
+    is_sums_current_ = false;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_thread_count(const size_t count)
+{
+    thread_count_ = count;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_shift_tolerance(const float tolerance)
+{
+    shift_tolerance_ = tolerance;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_inertia_tolerance(const float tolerance)
+{
+    inertia_tolerance_ = tolerance;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_reassignment_tolerance(const float fraction)
+{
+    reassignment_tolerance_ = fraction;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_empty_cluster_policy(const EmptyClusterPolicy policy)
+{
+    empty_cluster_policy_ = policy;
+}
+template<typename Sums>
+bool
+cluster::kMeansBase<Sums>::
+assign()
+{
+    mean_shift_ = 0;
+    const size_t workers = parallel::worker_count(n(), thread_count_);
+    // sum as we go only if every worker can own its sums
+    const bool is_summing = workers == sum_worker_count();
+    std::vector<std::vector<double>> partial_sizes(workers, std::vector<double>(k(), 0));
+    std::vector<Sums> partial_sums(is_summing ? workers : 0);
+    std::vector<size_t> partial_counts(workers, 0);
+    std::vector<double> partial_inertias(workers, 0);
+    parallel::for_each_range
+    (
+        n(), workers,
+        [this, is_summing, &partial_sizes, &partial_sums, &partial_counts, &partial_inertias]
+        (const size_t worker, const size_t begin, const size_t end)
+        {
+            if (!is_summing)
+            {
+                partial_counts[worker] = assign_range(begin, end, partial_sizes[worker]);
+            }
+            else
+            {
+                // each chunk is summed while it is still in cache
+                partial_sums[worker].resize(sum_length_);
+                for (size_t chunk_begin = begin; chunk_begin < end; )
+                {
+                    const size_t chunk_end =
+                        std::min(end, (chunk_begin / CHUNK_LENGTH + 1) * CHUNK_LENGTH);
+                    partial_counts[worker] += assign_and_sum_range(chunk_begin, chunk_end,
+                                                                   partial_sizes[worker],
+                                                                   partial_sums[worker]);
+                    chunk_begin = chunk_end;
+                }
+            }
+            partial_inertias[worker] = range_inertia(begin, end);
+        }
+    );
+    const bool is_changed = set_assignment(partial_sizes, partial_counts, partial_inertias);
+    if (is_summing) { set_sums(partial_sums); }
+    else if (is_changed) { is_sums_current_ = false; }
+    return is_changed;
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+assign_and_sum_range
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums& sums
+)
+{
+    const size_t reassigned_count = assign_range(begin, end, sizes);
+    update_range(begin, end, sums);
+    return reassigned_count;
+}
+template<typename Sums>
+double
+cluster::kMeansBase<Sums>::
+range_inertia(const size_t begin, const size_t end) const
+{
+    double inertia = 0;
+    if (weights_.empty())
+    {
+        for (size_t i = begin; i < end; ++i) { inertia += distances_[i]; }
+    }
+    else
+    {
+        for (size_t i = begin; i < end; ++i) { inertia += weights_[i] * distances_[i]; }
+    }
+    return inertia;
+}
+template<typename Sums>
+bool
+cluster::kMeansBase<Sums>::
+set_assignment
+(
+    const std::vector<std::vector<double>>& partial_sizes,
+    const std::vector<size_t>& partial_counts,
+    const std::vector<double>& partial_inertias
+)
+{
+    std::fill_n(cluster_sizes_.begin(), k(), 0);
+    reassigned_count_ = 0;
+    inertia_ = 0;
+    for (size_t i = 0; i < partial_sizes.size(); ++i)
+    {
+        for (size_t j = 0; j < k(); ++j)
+        {
+            cluster_sizes_[j] += partial_sizes[i][j];
+        }
+        reassigned_count_ += partial_counts[i];
+        inertia_ += partial_inertias[i];
+    }
+    return reassigned_count_ > 0;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+update()
+{
+    sums();
+    set_means();
+}
+template<typename Sums>
+bool
+cluster::kMeansBase<Sums>::
+iterate()
+{
+    if (!assign()) { return false; }
+    update();
+    return true;
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+sum_worker_count() const
+{
+    // Every worker owns k partial sums; capping the workers at n / k keeps
+    // the reduction no more expensive than the accumulation itself.
+    return parallel::worker_count(n() / std::max<size_t>(k(), 1), thread_count_);
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_sums(std::vector<Sums>& partial_sums)
+{
+    parallel::reduce
+    (
+        partial_sums,
+        [this](Sums& lhs, const Sums& rhs)
+        {
+            for (size_t i = 0; i < sum_length_; ++i)
+            {
+                lhs[i] += rhs[i];
+            }
+        }
+    );
+    sums_.swap(partial_sums.front());
+    is_sums_current_ = true;
+}
+template<typename Sums>
+const Sums&
+cluster::kMeansBase<Sums>::
+sums()
+{
+    if (!is_sums_current_)
+    {
+        const size_t workers = sum_worker_count();
+        std::vector<Sums> partial_sums(workers);
+        parallel::for_each_range
+        (
+            n(), workers,
+            [this, &partial_sums]
+            (const size_t worker, const size_t begin, const size_t end)
+            {
+                partial_sums[worker].resize(sum_length_);
+                update_range(begin, end, partial_sums[worker]);
+            }
+        );
+        set_sums(partial_sums);
+    }
+    return sums_;
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_means()
+{
+    const bool is_repairing =
+        empty_cluster_policy_ != EmptyClusterPolicy::keep &&
+        std::find(cluster_sizes_.begin(), cluster_sizes_.end(), 0.0) != cluster_sizes_.end();
+    // candidates are ranked against the means they were assigned to
+    if (is_repairing) { set_exact_distances(); }
+    for (size_t i = 0; i < k(); ++i)
+    {
+        if (cluster_size(i) == 0) { continue; }
+        set_mean_from_sums(i, sums_);
+    }
+    if (is_repairing) { repair_empty_clusters(); }
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+repair_empty_clusters()
+{
+    if (empty_cluster_policy_ == EmptyClusterPolicy::keep) { return; }
+
+    std::vector<char> is_taken(n(), 0);
+    for (size_t j = 0; j < k(); ++j)
+    {
+        if (cluster_size(j) != 0) { continue; }
+
+        const size_t largest = std::max_element(cluster_sizes_.begin(),
+                                                cluster_sizes_.end()) -
+                               cluster_sizes_.begin();
+        const bool is_splitting =
+            empty_cluster_policy_ == EmptyClusterPolicy::split_largest;
+        size_t farthest = n();
+        for (size_t i = 0; i < n(); ++i)
+        {
+            if (weight(i) == 0 ||
+                (is_splitting && assigned_clusters_[i] != largest) ||
+                is_taken[i])
+            {
+                continue;
+            }
+            if (farthest == n() || distances_[i] > distances_[farthest])
+            {
+                farthest = i;
+            }
+        }
+        if (farthest == n()) { return; }
+        is_taken[farthest] = 1;
+        set_mean_to_observation(j, farthest);
+    }
+}
+template<typename Sums>
+void
+cluster::kMeansBase<Sums>::
+set_exact_distances() {}
+template<typename Sums>
+bool
+cluster::kMeansBase<Sums>::
+is_within_tolerance(const double previous_inertia) const
+{
+    const bool is_shift_small =
+        shift_tolerance_ > 0 && mean_shift_ <= shift_tolerance_;
+    const bool is_improvement_small =
+        inertia_tolerance_ > 0 &&
+        previous_inertia < std::numeric_limits<double>::infinity() &&
+        previous_inertia - inertia_ <= inertia_tolerance_ * previous_inertia;
+    const bool is_reassignment_small =
+        reassigned_count_ <= reassignment_tolerance_ * n();
+    return is_shift_small || is_improvement_small || is_reassignment_small;
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+run(const size_t max_iterations)
+{
+    return run(max_iterations, [](double) { return false; });
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+run
+(
+    const size_t max_iterations,
+    const std::function<bool(double)>& is_stopping
+)
+{
+    size_t i = 0;
+    double previous_inertia = std::numeric_limits<double>::infinity();
+    while (i < max_iterations && iterate())
+    {
+        ++ i;
+        if (is_within_tolerance(previous_inertia) || 
+            is_stopping(previous_inertia)) 
+        { 
+            break; 
+        }
+        previous_inertia = inertia_;
+    }
+    return i;
+}
+
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+cluster(const size_t index) const
+{
+    return assigned_clusters_.at(index);
+}
+template<typename Sums>
+double
+cluster::kMeansBase<Sums>::
+cluster_size(const size_t index) const
+{
+    return cluster_sizes_.at(index);
+}
+template<typename Sums>
+float
+cluster::kMeansBase<Sums>::
+weight(const size_t index) const
+{
+    return weights_.empty() ? 1.0f : weights_.at(index);
+}
+template<typename Sums>
+bool
+cluster::kMeansBase<Sums>::
+is_weighted() const
+{
+    return !weights_.empty();
+}
+template<typename Sums>
+float
+cluster::kMeansBase<Sums>::
+distance(const size_t index) const
+{
+    return distances_.at(index);
+}
+template<typename Sums>
+double
+cluster::kMeansBase<Sums>::
+inertia() const
+{
+    return inertia_;
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+reassigned_count() const
+{
+    return reassigned_count_;
+}
+template<typename Sums>
+float
+cluster::kMeansBase<Sums>::
+mean_shift() const
+{
+    return mean_shift_;
+}
+
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+n() const
+{
+    return observation_count_;
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+k() const
+{
+    return cluster_sizes_.size();
+}
+template<typename Sums>
+size_t
+cluster::kMeansBase<Sums>::
+thread_count() const
+{
+    return thread_count_;
+}
@@ -0,0 +1,428 @@
+#ifndef K_MEANS_BASE_H
+#define K_MEANS_BASE_H
+/**
+ * @file kMeansBase.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBase.
+ */
+
+
+#include "parallel.hpp"
+
+#include <functional>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Tag type selecting constructors that borrow observations.
+     */
+    struct BorrowTag {};
+    /**
+     * Tag selecting constructors that borrow observations instead of
+     * copying them.
+     */
+    const BorrowTag borrow = BorrowTag();
+
+    /**
+     * Ways to place the mean of a cluster left without observations.
+     */
+    enum class EmptyClusterPolicy
+    {
+        keep,           // leave the mean where it was
+        farthest,       // move it to the observation farthest from its mean
+        split_largest   // move it to the farthest observation of the largest cluster
+    };
+
+    /**
+     * The part of a k-means solver that does not depend on how observations
+     * and means are stored: threading, weights, cluster bookkeeping,
+     * termination and empty-cluster repair.
+     *
+     * @details
+     *  Derived classes own the observations and means, and provide the
+     *  kernels: assign_range(), update_range(), set_mean_from_sums() and
+     *  set_mean_to_observation().
+     *
+     * @tparam Sums Per-cluster sums of observations, a sequence of
+     *              sum_length values that value-initialize to zero and add
+     *              element-wise with +=.
+     */
+    template<typename Sums>
+    class kMeansBase
+    {
+        public:
+        virtual ~kMeansBase() {}
+
+        /**
+         * Sets per-observation weights.
+         *
+         * @details
+         *  An observation of weight w counts as w observations: it adds w to
+         *  its cluster's size, and w times itself to its cluster's sum, so
+         *  means are weighted averages. By default all weights are one.
+         *
+         * @param weights Pointer to first weight in sequence, or nullptr to
+         *                reset all weights to one.
+         *
+         * @pre Sequence has length >= number of observations, and weights
+         *      are non-negative.
+         */
+        virtual void set_weights(const float* weights);
+
+        /**
+         * Sets number of worker threads used by assign() and update().
+         *
+         * @details
+         *  Observations are split into contiguous ranges, one per worker.
+         *  Assignments are identical to those of a single thread. Means are
+         *  summed per worker and combined with a tree reduction, so they may
+         *  differ from those of a single thread by rounding.
+         *
+         * @param count Number of threads. Zero selects the hardware's
+         *              concurrency. Default is one.
+         */
+        void set_thread_count(size_t count);
+
+        /**
+         * Sets tolerance of the mean shift that ends run().
+         *
+         * @details
+         *  run() stops after an iteration in which no mean moved by more
+         *  than tolerance, as measured by the distance function.
+         *
+         * @param tolerance Tolerance > 0, or zero to disable. Default is zero.
+         */
+        void set_shift_tolerance(float tolerance);
+        /**
+         * Sets tolerance of the relative inertia improvement that ends run().
+         *
+         * @details
+         *  run() stops after an iteration whose assignment improved inertia
+         *  by no more than tolerance times the previous inertia.
+         *
+         * @param tolerance Tolerance > 0, or zero to disable. Default is zero.
+         */
+        void set_inertia_tolerance(float tolerance);
+        /**
+         * Sets fraction of reassigned observations that ends run().
+         *
+         * @details
+         *  run() stops after an iteration that reassigned no more than
+         *  fraction * n observations.
+         *
+         * @param fraction Fraction in [0, 1]. Default is zero, which stops
+         *                 only once no observation is reassigned.
+         */
+        void set_reassignment_tolerance(float fraction);
+
+        /**
+         * Sets how update() places the means of empty clusters.
+         *
+         * @details
+         *  Candidate observations are ranked by their distance to the mean
+         *  they were assigned to. Engines whose distance(i) is a bound
+         *  first compute these distances exactly, with one distance per
+         *  observation, but only in updates that leave a cluster empty.
+         *  Each empty cluster takes a different observation, which moves
+         *  to it at the next assignment.
+         *
+         * @param policy Policy. Default is EmptyClusterPolicy::farthest.
+         */
+        void set_empty_cluster_policy(EmptyClusterPolicy policy);
+
+        /**
+         * Assign observations to clusters.
+         *
+         * @details
+         *  After a call to assign(), the assigned clusters can be
+         *  inspected through a call to cluster(size_t observation_index).
+         *
+         *  Unless there are more workers than there are observations per
+         *  cluster, each observation is also added into its cluster's sum
+         *  as soon as it is assigned, so that update() makes no pass over
+         *  the observations.
+         *
+         * @returns True if there was change in cluster assignment.
+         */
+        virtual bool assign();
+
+        /**
+         * Update cluster means based on current observation-cluster assignment.
+         *
+         * @details
+         *  After a call to update(), the updated means can be
+         *  inspected through a call to mean(size_t cluster_index).
+         */
+        virtual void update();
+
+        /**
+         * Performs a single iteration: assignment, followed by update if there
+         * was change in cluster assignment.
+         *
+         * @details
+         *  Engines customize assign() and update(), and all share this. The
+         *  observations are streamed through memory once, @see assign.
+         *
+         * @returns True if there was change in cluster assignment.
+         */
+        virtual bool iterate();
+
+        /**
+         * Repeats iterate() until termination condition is met, or
+         * maximum number of iterations have been performed.
+         *
+         * @details
+         *  Terminates once an iteration changes no assignment, or falls
+         *  within one of the tolerances, @see set_shift_tolerance,
+         *  set_inertia_tolerance and set_reassignment_tolerance.
+         *
+         * @param max_iterations Maximum number of iterations to perform.
+         *
+         * @return Number of iterations until termination.
+         */
+        size_t run(size_t max_iterations);
+        /**
+         * Repeats iterate() as run(max_iterations) does, and also stops
+         * when asked to.
+         *
+         * @details
+         *  is_stopping is called after every iteration that does not end
+         *  the run otherwise, and the run ends if it returns true.
+         *
+         * @param max_iterations Maximum number of iterations to perform.
+         * @param is_stopping    Called with the inertia before the
+         *                       iteration, or infinity after the first.
+         *
+         * @return Number of iterations until termination.
+         */
+        size_t run(size_t max_iterations,
+                   const std::function<bool(double)>& is_stopping);
+
+        /**
+         * Gets number of observations.
+         */
+        size_t n() const;
+        /**
+         * Gets number of clusters.
+         */
+        size_t k() const;
+        /**
+         * Gets number of worker threads, as set by set_thread_count().
+         */
+        size_t thread_count() const;
+
+        /**
+         * Gets cluster index of observation at index.
+         *
+         * @pre index is in [0, #(observations)).
+         *
+         * @note Default value for unassigned observations is cluster zero.
+         */
+        size_t cluster(size_t index) const;
+        /**
+         * Gets the total weight of observations assigned to cluster at index.
+         *
+         * @details Without weights, the number of observations.
+         *
+         * @pre index is in [0, k).
+         */
+        double cluster_size(size_t index) const;
+        /**
+         * Gets weight of observation at index.
+         *
+         * @pre index is in [0, #(observations)).
+         */
+        float weight(size_t index) const;
+        /**
+         * Checks whether weights were set by set_weights().
+         */
+        bool is_weighted() const;
+
+        /**
+         * Gets distance of observation at index to its assigned mean, as
+         * of the last assignment.
+         *
+         * @details
+         *  Engines that skip distance computations report an upper bound
+         *  instead, with the same units as the distance function.
+         *
+         * @pre index is in [0, #(observations)).
+         */
+        float distance(size_t index) const;
+        /**
+         * Gets the inertia of the last assignment: the weighted sum of
+         * distances from observations to their assigned means.
+         *
+         * @details
+         *  Exact, up to rounding, also on engines whose distance(i) is an 
+         *  upper bound.
+         */
+        double inertia() const;
+        /**
+         * Gets number of observations whose cluster changed in the last
+         * assignment.
+         */
+        size_t reassigned_count() const;
+        /**
+         * Gets the largest distance a mean moved since the last assignment.
+         */
+        float mean_shift() const;
+
+        protected:
+        /**
+         * Initialize a new instance for given number of clusters and
+         * observations.
+         *
+         * @param k          Number of clusters.
+         * @param n          Number of observations.
+         * @param sum_length Length of Sums holding the sums of k clusters.
+         */
+        kMeansBase(size_t k, size_t n, size_t sum_length);
+
+        /**
+         * Assigns observations in [begin, end) to clusters.
+         *
+         * @details
+         *  Called by assign() from each worker thread on disjoint ranges.
+         *  Also sets distances_ of the observations in range.
+         *
+         * @param sizes Per-cluster observation weights to add to.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        virtual size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) = 0;
+        /**
+         * Assigns observations in [begin, end) to clusters, and sums them
+         * by their new cluster.
+         *
+         * @details
+         *  Called by assign() instead of assign_range() when it sums as it
+         *  assigns, on ranges short enough to still be in cache. Calls
+         *  assign_range() and then update_range(); kernels that can sum
+         *  each observation as they assign it override this.
+         *
+         * @param sizes Per-cluster observation weights to add to.
+         * @param sums  Per-cluster sums to add to.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        virtual size_t assign_and_sum_range(size_t begin, size_t end,
+                                            std::vector<double>& sizes, Sums& sums);
+        /**
+         * Sums weighted observations in [begin, end) by assigned cluster.
+         *
+         * @param sums Per-cluster sums to add to.
+         */
+        virtual void update_range(size_t begin, size_t end, Sums& sums) const = 0;
+        /**
+         * Sets mean of a non-empty cluster from the sums of the current
+         * assignment, divided by its size.
+         *
+         * @details Also raises mean_shift_ to how far the mean moved.
+         */
+        virtual void set_mean_from_sums(size_t index, const Sums& sums) = 0;
+        /**
+         * Moves mean of cluster at index onto an observation.
+         *
+         * @details Also raises mean_shift_ to how far the mean moved.
+         */
+        virtual void set_mean_to_observation(size_t index, size_t observation_index) = 0;
+        /**
+         * Replaces bounds in distances_ with exact distances to the
+         * assigned means.
+         *
+         * @details
+         *  Called by update() before it repairs empty clusters, while the
+         *  means are still those of the last assignment. Does nothing by
+         *  default, for engines whose distances_ are exact.
+         */
+        virtual void set_exact_distances();
+
+        /**
+         * Sets cluster sizes, reassigned count and inertia from the results
+         * of assign_range() on each worker.
+         *
+         * @returns True if there was change in cluster assignment.
+         */
+        bool set_assignment(const std::vector<std::vector<double>>& partial_sizes,
+                            const std::vector<size_t>& partial_counts,
+                            const std::vector<double>& partial_inertias);
+        /**
+         * Gets weighted sum of distances_ over [begin, end).
+         */
+        double range_inertia(size_t begin, size_t end) const;
+        /**
+         * Sets the per-cluster sums of the current assignment, for update().
+         *
+         * @param partial_sums Per-worker sums, reduced in place.
+         */
+        void set_sums(std::vector<Sums>& partial_sums);
+        /**
+         * Gets the per-cluster sums of the current assignment.
+         *
+         * @details Sums the observations first, unless assign() already did.
+         */
+        const Sums& sums();
+        /**
+         * Moves the means of empty clusters, as set by
+         * set_empty_cluster_policy().
+         *
+         * @details
+         *  Called by update() after setting the other means, and after
+         *  set_exact_distances() if a cluster is empty.
+         */
+        void repair_empty_clusters();
+
+        size_t observation_count_;
+        std::vector<size_t> assigned_clusters_;
+        std::vector<double> cluster_sizes_;
+        size_t thread_count_;
+        std::vector<float> weights_;  // empty when unweighted
+        std::vector<float> distances_;
+        size_t reassigned_count_;
+        double inertia_;
+        float mean_shift_;
+        float shift_tolerance_;
+        float inertia_tolerance_;
+        float reassignment_tolerance_;
+        EmptyClusterPolicy empty_cluster_policy_;
+
+        private:
+        /**
+         * Number of consecutive observations assign() assigns before summing
+         * them, few enough to still be in cache.
+         */
+        static const size_t CHUNK_LENGTH = 256;
+
+        /**
+         * Gets number of workers that accumulate private per-cluster sums.
+         */
+        size_t sum_worker_count() const;
+        /**
+         * Checks whether the last iteration fell within a tolerance.
+         *
+         * @param previous_inertia Inertia of the assignment before it, or
+         *                         infinity for the first iteration.
+         */
+        bool is_within_tolerance(double previous_inertia) const;
+        /**
+         * Sets means from the sums and current cluster sizes, and repairs
+         * empty clusters.
+         */
+        void set_means();
+
+        size_t sum_length_;
+        Sums sums_;
+        bool is_sums_current_;  // sums_ belong to the current assignment
+    };
+ }
+
+
+#include "kMeansBase.cpp"
+
+
+#endif  // K_MEANS_BASE_H
@@ -0,0 +1,122 @@
+/**
+ * @file kMeansBlocked.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBlocked.
+ */
+
+
+#include "kMeansBlocked.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansBlocked<T, D, Distance>::
+kMeansBlocked
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeans<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    blocks_((this->n() + LANE_COUNT - 1) / LANE_COUNT * D * LANE_COUNT, 0),
+    flat_means_(k * D)
+{
+    for (size_t i = 0; i < this->n(); ++i)
+    {
+        const Vector<T, D>& obs = this->observation(i);
+        T* block = &blocks_[i / LANE_COUNT * D * LANE_COUNT];
+        for (size_t d = 0; d < D; ++d)
+        {
+            block[d * LANE_COUNT + i % LANE_COUNT] = obs[d];
+        }
+    }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool 
+cluster::kMeansBlocked<T, D, Distance>::
+assign()
+{
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        const Vector<T, D>& mean = this->mean(j);
+        for (size_t d = 0; d < D; ++d)
+        {
+            flat_means_[j * D + d] = mean[d];
+        }
+    }
+    return kMeans<T, D, Distance>::assign();
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansBlocked<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    const size_t k = this->k();
+    size_t reassigned_count = 0;
+    for (size_t block_begin = begin / LANE_COUNT * LANE_COUNT; 
+         block_begin < end; 
+         block_begin += LANE_COUNT)
+    {
+        const T* block = &blocks_[block_begin * D];
+        float nearest_mean_distances[LANE_COUNT];
+        unsigned int nearest_mean_indices[LANE_COUNT] = {};
+        block_distances(block, &flat_means_[0], nearest_mean_distances);
+        float distances[LANE_COUNT];
+        for (size_t j = 1; j < k; ++j)
+        {
+            const unsigned int mean_index = static_cast<unsigned int>(j);
+            block_distances(block, &flat_means_[j * D], distances);
+            for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+            {
+                // selection by mask rather than branch, so lanes are 
+                // compared in parallel
+                const float distance = distances[lane];
+                const unsigned int is_nearer_mask = 
+                    0u - static_cast<unsigned int>(distance < nearest_mean_distances[lane]);
+                nearest_mean_distances[lane] = std::min(nearest_mean_distances[lane], 
+                                                        distance);
+                nearest_mean_indices[lane] = (nearest_mean_indices[lane] & ~is_nearer_mask) |
+                                             (mean_index & is_nearer_mask);
+            }
+        }
+
+        const size_t lane_begin = std::max(begin, block_begin) - block_begin,
+                     lane_end = std::min(end, block_begin + LANE_COUNT) - block_begin;
+        for (size_t lane = lane_begin; lane < lane_end; ++lane)
+        {
+            size_t& assigned = this->assigned_clusters_.at(block_begin + lane);
+            if (assigned != nearest_mean_indices[lane]) { ++ reassigned_count; }
+            assigned = nearest_mean_indices[lane];
+            this->distances_[block_begin + lane] = nearest_mean_distances[lane];
+            sizes.at(assigned) += this->weight(block_begin + lane);
+        }
+    }
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansBlocked<T, D, Distance>::
+block_distances(const T* block, const T* mean, float* distances)
+{
+    std::fill_n(distances, LANE_COUNT, 0.0f);
+    for (size_t d = 0; d < D; ++d)
+    {
+        // one contiguous loop over the lanes per dimension; each lane still
+        // accumulates in the order and types of the scalar distance 
+        // functions, so results match them exactly
+        const T* values = block + d * LANE_COUNT;
+        const T mean_value = mean[d];
+        for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+        {
+            const T difference = values[lane] - mean_value;
+            distances[lane] += IS_EUCLIDEAN2 ? 
+                               difference * difference : 
+                               std::abs(difference);
+        }
+    }
+}
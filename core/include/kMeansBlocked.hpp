@@ -0,0 +1,100 @@
+#ifndef K_MEANS_BLOCKED_H
+#define K_MEANS_BLOCKED_H
+/**
+ * @file kMeansBlocked.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBlocked.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means over observations stored in blocked structure-of-arrays layout.
+     *
+     * @details
+     *  On construction, observations are copied into blocks of LANE_COUNT 
+     *  observations, stored dimension by dimension (AoSoA). Means are copied 
+     *  into a flat array before each assignment. The assignment kernel then 
+     *  computes the distances from a whole block to a mean with one 
+     *  contiguous loop per dimension, which compilers vectorize across 
+     *  observations. This pays off most for small Dimension, where a single 
+     *  observation fills only a fraction of a vector register.
+     *
+     *  The blocked copy is kept in addition to the observations of kMeans;
+     *  construct with cluster::borrow to avoid holding a third copy.
+     *
+     *  Distance must be distance::euclidean2 or distance::manhattan. 
+     *  Assignments are the same as those of kMeans, except for float data 
+     *  of dimension simd::MIN_DIMENSION or more, where kMeans sums distances
+     *  in a different order and they may differ by rounding.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansBlocked : public kMeans<NumericType, Dimension, Distance>
+    {
+        static_assert(distance::is_euclidean2<NumericType, Dimension, Distance>::value ||
+                      distance::is_manhattan<NumericType, Dimension, Distance>::value, 
+                      "blocked layout requires distance::euclidean2 or distance::manhattan");
+
+        public:
+        /**
+         * Number of observations per block.
+         */
+        static const size_t LANE_COUNT = 16;
+
+        /**
+         * @see kMeans::kMeans
+         *
+         * @details 
+         *  Accepts the arguments of any kMeans constructor. Copies the 
+         *  observations into blocked layout.
+         */
+        template<typename... Arguments>
+        kMeansBlocked(size_t k, Arguments&&... arguments);
+
+        /**
+         * @see kMeans::assign
+         */
+        bool assign() override;
+
+        protected:
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+
+        private:
+        static const bool IS_EUCLIDEAN2 = 
+            distance::is_euclidean2<NumericType, Dimension, Distance>::value;
+
+        /**
+         * Computes the distances from all observations in a block to a mean.
+         *
+         * @param distances Receives LANE_COUNT distances.
+         */
+        static void block_distances(const NumericType* block, const NumericType* mean, 
+                                    float* distances);
+
+        std::vector<NumericType> blocks_;
+        std::vector<NumericType> flat_means_;
+    };
+ }
+
+
+#include "kMeansBlocked.cpp"
+
+
+#endif  // K_MEANS_BLOCKED_H
@@ -0,0 +1,159 @@
+/**
+ * @file kMeansBounded.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBounded.
+ */
+
+
+#include "kMeansBounded.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansBounded<T, D, Distance>::
+kMeansBounded
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeans<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    is_bounded_(false),
+    half_nearest_mean_distances_(k),
+    norm_sum_(0),
+    is_norm_sum_current_(false) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+initialize(const Vector<T, D>* means)
+{
+    kMeans<T, D, Distance>::initialize(means);
+    is_bounded_ = false;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+set_weights(const float* weights)
+{
+    kMeans<T, D, Distance>::set_weights(weights);
+    is_norm_sum_current_ = false;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool
+cluster::kMeansBounded<T, D, Distance>::
+assign()
+{
+    prepare_bounds();
+    const bool is_changed = kMeans<T, D, Distance>::assign();
+    is_bounded_ = true;
+    // distances_ now hold upper bounds
+    set_exact_inertia(distance::is_euclidean2<T, D, Distance>());
+    return is_changed;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+update()
+{
+    const std::vector<Vector<T, D>> previous_means(this->mean_observations_);
+    kMeans<T, D, Distance>::update();
+    if (!is_bounded_) { return; }
+
+    std::vector<float> shifts(this->k());
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        shifts[j] = metric(previous_means[j], this->mean(j));
+    }
+    shift_bounds(shifts);
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+set_exact_inertia(std::true_type)
+{
+    if (!is_norm_sum_current_)
+    {
+        norm_sum_ = 0;
+        for (size_t i = 0; i < this->n(); ++i) { norm_sum_ += this->weighted_norm(i); }
+        is_norm_sum_current_ = true;
+    }
+    // sums() costs no pass when assign() summed as it went
+    const std::vector<Vector<T, D>>& sums = this->sums();
+    double inertia = norm_sum_;
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        inertia += this->expanded_inertia(0, sums[j], this->cluster_size(j), this->mean(j));
+    }
+    this->inertia_ = std::max(0.0, inertia);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+set_exact_inertia(std::false_type)
+{
+    const size_t workers = parallel::worker_count(this->n(), this->thread_count());
+    std::vector<double> partial_inertias(workers, 0);
+    parallel::for_each_range
+    (
+        this->n(), workers,
+        [this, &partial_inertias](const size_t worker, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                partial_inertias[worker] += 
+                    this->weight(i) * Distance(this->observation(i), 
+                                               this->mean(this->cluster(i)));
+            }
+        }
+    );
+    this->inertia_ = 0;
+    for (const double inertia : partial_inertias) { this->inertia_ += inertia; }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+float
+cluster::kMeansBounded<T, D, Distance>::
+metric(const Vector<T, D>& a, const Vector<T, D>& b)
+{
+    return std::sqrt(Distance(a, b));
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+compute_mean_distances(std::vector<float>* half_mean_distances)
+{
+    const size_t k = this->k();
+    std::fill_n(half_nearest_mean_distances_.begin(), k,
+                std::numeric_limits<float>::infinity());
+    for (size_t a = 0; a < k; ++a)
+    {
+        if (half_mean_distances != nullptr) { (*half_mean_distances)[a * k + a] = 0.0f; }
+        for (size_t b = a + 1; b < k; ++b)
+        {
+            const float half_distance = 0.5f * metric(this->mean(a), this->mean(b));
+            if (half_mean_distances != nullptr)
+            {
+                (*half_mean_distances)[a * k + b] = half_distance;
+                (*half_mean_distances)[b * k + a] = half_distance;
+            }
+            half_nearest_mean_distances_[a] = std::min(half_nearest_mean_distances_[a],
+                                                       half_distance);
+            half_nearest_mean_distances_[b] = std::min(half_nearest_mean_distances_[b],
+                                                       half_distance);
+        }
+    }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansBounded<T, D, Distance>::
+set_exact_distances()
+{
+    this->compute_distances();
+}
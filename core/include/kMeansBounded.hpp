@@ -0,0 +1,142 @@
+#ifndef K_MEANS_BOUNDED_H
+#define K_MEANS_BOUNDED_H
+/**
+ * @file kMeansBounded.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansBounded.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Base of engines that skip distance computations with triangle-
+     * inequality bounds.
+     *
+     * @details
+     *  Bounds are kept on the metric underlying Distance, its square root,
+     *  which must satisfy the triangle inequality. This holds for
+     *  distance::euclidean2 and distance::manhattan.
+     *
+     *  Bounds are valid from the first assignment after initialize(). After
+     *  each update(), derived classes loosen them by how far every mean
+     *  moved.
+     *
+     *  distance(i) reports the upper bound. inertia() is computed exactly 
+     *  after each assignment: for distance::euclidean2 from the cluster 
+     *  sums, without a pass over the observations, and otherwise with one 
+     *  distance per observation.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansBounded : public kMeans<NumericType, Dimension, Distance>
+    {
+        public:
+        /**
+         * @see kMeans::kMeans
+         *
+         * @details Accepts the arguments of any kMeans constructor.
+         */
+        template<typename... Arguments>
+        kMeansBounded(size_t k, Arguments&&... arguments);
+
+        /**
+         * @see kMeans::initialize
+         *
+         * @details Invalidates the bounds.
+         */
+        void initialize(const Vector<NumericType, Dimension>* means) override;
+
+        /**
+         * @see kMeans::set_weights
+         */
+        void set_weights(const float* weights) override;
+
+        /**
+         * @see kMeans::assign
+         */
+        bool assign() override;
+
+        /**
+         * @see kMeans::update
+         */
+        void update() override;
+
+        protected:
+        /**
+         * Computes the metric underlying Distance.
+         */
+        static float metric(const Vector<NumericType, Dimension>& a,
+                            const Vector<NumericType, Dimension>& b);
+
+        /**
+         * Prepares the bounds for an assignment.
+         *
+         * @details Called by assign(), before is_bounded_ is set.
+         */
+        virtual void prepare_bounds() = 0;
+        /**
+         * Loosens the bounds by how far each mean moved.
+         *
+         * @details Called by update() while the bounds are valid.
+         *
+         * @param shifts Metric from each mean's previous position to its
+         *               current one.
+         */
+        virtual void shift_bounds(const std::vector<float>& shifts) = 0;
+
+        /**
+         * Computes half the distance from each mean to its nearest other
+         * mean, into half_nearest_mean_distances_.
+         *
+         * @param half_mean_distances Receives half the distances between all
+         *                            pairs of means, row-major, or nullptr.
+         */
+        void compute_mean_distances(std::vector<float>* half_mean_distances);
+        /**
+         * @see kMeansBase::set_exact_distances
+         */
+        void set_exact_distances() override;
+
+        bool is_bounded_;
+        std::vector<float> half_nearest_mean_distances_;
+
+        private:
+        /**
+         * Sets inertia_ of the current assignment from the cluster sums.
+         *
+         * @details For distance::euclidean2, @see kMeans::expanded_inertia.
+         */
+        void set_exact_inertia(std::true_type);
+        /**
+         * Sets inertia_ of the current assignment with a distance per 
+         * observation.
+         */
+        void set_exact_inertia(std::false_type);
+
+        double norm_sum_;  // weighted sum of squared observation norms
+        bool is_norm_sum_current_;
+    };
+ }
+
+
+#include "kMeansBounded.cpp"
+
+
+#endif  // K_MEANS_BOUNDED_H
@@ -0,0 +1,207 @@
+/**
+ * @file kMeansCompressed.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansCompressed.
+ */
+
+
+#include "kMeansCompressed.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+kMeansCompressed
+(
+    size_t k,
+    const Vector<float, D>* obs, size_t n
+) :
+    kMeansBase<Sums>(k, n, k * D),
+    codes_(n * D),
+    mean_observations_(k)
+{
+    codec_.fit(obs, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        codec_.encode(obs[i], &codes_[i * D]);
+    }
+}
+
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+initialize(const Vector<float, D>* means)
+{
+    for (size_t i = 0; i < this->k(); ++i)
+    {
+        set_mean(i, means[i]);
+    }
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+size_t
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    return assign_kernel<false>(begin, end, sizes, nullptr);
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+size_t
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+assign_and_sum_range
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums& sums
+)
+{
+    // each observation is decoded once, for both its distances and its sum
+    return assign_kernel<true>(begin, end, sizes, &sums);
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+template<bool IsSumming>
+size_t
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+assign_kernel
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums* sums
+)
+{
+    const size_t k = this->k();
+    Vector<float, D> obs;
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        // decoded once, then compared with every mean
+        decode(i, obs);
+        size_t nearest_mean_index = 0;
+        float nearest_mean_distance = Distance(obs, mean_observations_[0]);
+        for (size_t j = 1; j < k; ++j)
+        {
+            const float distance_to_j = Distance(obs, mean_observations_[j]);
+            if (distance_to_j < nearest_mean_distance)
+            {
+                nearest_mean_index = j;
+                nearest_mean_distance = distance_to_j;
+            }
+        }
+        if (this->assigned_clusters_[i] != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_[i] = nearest_mean_index;
+        this->distances_[i] = nearest_mean_distance;
+        sizes[nearest_mean_index] += this->weight(i);
+        if (IsSumming)
+        {
+            add_weighted(i, obs, &(*sums)[nearest_mean_index * D]);
+        }
+    }
+    return reassigned_count;
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+update_range(const size_t begin, const size_t end, Sums& sums) const
+{
+    Vector<float, D> obs;
+    for (size_t i = begin; i < end; ++i)
+    {
+        decode(i, obs);
+        add_weighted(i, obs, &sums[this->assigned_clusters_[i] * D]);
+    }
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+add_weighted(const size_t index, const Vector<float, D>& obs, A* sum) const
+{
+    const float* values = obs.data();
+    if (!this->is_weighted())
+    {
+        for (size_t d = 0; d < D; ++d) { sum[d] += values[d]; }
+    }
+    else
+    {
+        const A weight = this->weights_[index];
+        for (size_t d = 0; d < D; ++d) { sum[d] += values[d] * weight; }
+    }
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+set_mean_from_sums(const size_t index, const Sums& sums)
+{
+    const A* sum = &sums[index * D];
+    Vector<float, D> mean;
+    for (size_t d = 0; d < D; ++d)
+    {
+        mean[d] = static_cast<float>(sum[d] / this->cluster_size(index));
+    }
+    set_mean(index, mean);
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+set_mean_to_observation(const size_t index, const size_t observation_index)
+{
+    set_mean(index, observation(observation_index));
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+set_mean(const size_t index, const Vector<float, D>& mean)
+{
+    this->mean_shift_ = std::max(this->mean_shift_, 
+                                 Distance(mean_observations_.at(index), mean));
+    mean_observations_.at(index) = mean;
+}
+
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+void
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+decode(const size_t index, Vector<float, D>& obs) const
+{
+    codec_.decode(&codes_[index * D], obs);
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+const Codec<D>&
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+codec() const
+{
+    return codec_;
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+cluster::Vector<float, D>
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+observation(const size_t index) const
+{
+    if (index >= this->n())
+    {
+        throw std::out_of_range("observation index out of range");
+    }
+    Vector<float, D> obs;
+    decode(index, obs);
+    return obs;
+}
+template<template<size_t> class Codec, size_t D, 
+         cluster::DistanceFunction<float, D> Distance, typename A>
+const cluster::Vector<float, D>&
+cluster::kMeansCompressed<Codec, D, Distance, A>::
+mean(const size_t index) const
+{
+    return mean_observations_.at(index);
+}
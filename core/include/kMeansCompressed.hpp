@@ -0,0 +1,158 @@
+#ifndef K_MEANS_COMPRESSED_H
+#define K_MEANS_COMPRESSED_H
+/**
+ * @file kMeansCompressed.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansCompressed.
+ */
+
+
+#include "codec.hpp"
+#include "kMeans.hpp"
+
+#include <type_traits>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means over observations stored in reduced precision.
+     *
+     * @details
+     *  On construction, observations are encoded by a codec, such as
+     *  codec::BFloat16 or codec::Half (2 bytes per value) or codec::Int8
+     *  (1 byte per value), instead of 4 bytes per float. Each pass decodes
+     *  an observation once into float, and computes its distances to the
+     *  means in float. This cuts the memory traffic of each pass by 2-4x,
+     *  at the cost of the codec's precision.
+     *
+     *  Means are kept in float. Cluster sums are accumulated in
+     *  Accumulator, double by default, so that they do not lose precision
+     *  over many observations. Weights, threads, tolerances and 
+     *  empty-cluster repair are those of kMeans, @see kMeansBase.
+     *
+     * @tparam Codec       Codec template, @see codec.
+     * @tparam Dimension   Data dimension.
+     * @tparam Distance    Distance function over decoded observations.
+     * @tparam Accumulator Type of cluster sums.
+     */
+    template
+    <
+        template<size_t> class Codec,
+        size_t Dimension,
+        DistanceFunction<float, Dimension> Distance,
+        typename Accumulator = double
+    >
+    class kMeansCompressed : public kMeansBase<std::vector<Accumulator>>
+    {
+        static_assert(std::is_floating_point<Accumulator>::value,
+                      "floating-point accumulator required");
+
+        public:
+        typedef typename Codec<Dimension>::Code Code;
+
+        /**
+         * Initialize a new instance for given number of clusters and
+         * observation sequence.
+         *
+         * @details Observations are encoded; the sequence is not kept.
+         *
+         * @param k            Number of clusters.
+         * @param observations Pointer to first observation in sequence.
+         * @param n            Number of observations to read from sequence.
+         */
+        kMeansCompressed(size_t k,
+                         const Vector<float, Dimension>* observations, size_t n);
+
+        /**
+         * @see kMeans::initialize
+         */
+        void initialize(const Vector<float, Dimension>* means);
+
+        /**
+         * Gets the codec.
+         */
+        const Codec<Dimension>& codec() const;
+
+        /**
+         * Gets decoded observation at index.
+         *
+         * @pre index is in [0, #(observations)).
+         */
+        Vector<float, Dimension> observation(size_t index) const;
+        /**
+         * Gets mean observation of cluster at index.
+         *
+         * @pre index is in [0, k).
+         */
+        const Vector<float, Dimension>& mean(size_t index) const;
+
+        protected:
+        typedef std::vector<Accumulator> Sums;
+
+        /**
+         * @see kMeansBase::assign_range
+         */
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+        /**
+         * @see kMeansBase::assign_and_sum_range
+         */
+        size_t assign_and_sum_range(size_t begin, size_t end,
+                                    std::vector<double>& sizes, Sums& sums) override;
+        /**
+         * @see kMeansBase::update_range
+         */
+        void update_range(size_t begin, size_t end, Sums& sums) const override;
+        /**
+         * @see kMeansBase::set_mean_from_sums
+         */
+        void set_mean_from_sums(size_t index, const Sums& sums) override;
+        /**
+         * @see kMeansBase::set_mean_to_observation
+         */
+        void set_mean_to_observation(size_t index, size_t observation_index) override;
+
+        private:
+        /**
+         * Decodes observation at index.
+         */
+        void decode(size_t index, Vector<float, Dimension>& observation) const;
+        /**
+         * Assigns observations in [begin, end) to clusters, optionally
+         * summing them by their new cluster.
+         *
+         * @tparam IsSumming Whether to add observations into sums.
+         *
+         * @param sizes Per-cluster observation weights to add to.
+         * @param sums  Per-cluster sums (k * Dimension) to add to.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        template<bool IsSumming>
+        size_t assign_kernel(size_t begin, size_t end,
+                             std::vector<double>& sizes, Sums* sums);
+        /**
+         * Adds observation at index, decoded, times its weight, to the sum
+         * of a cluster.
+         */
+        void add_weighted(size_t index, const Vector<float, Dimension>& observation,
+                          Accumulator* sum) const;
+        /**
+         * Sets mean of cluster at index.
+         */
+        void set_mean(size_t index, const Vector<float, Dimension>& mean);
+
+        Codec<Dimension> codec_;
+        std::vector<Code> codes_;
+        std::vector<Vector<float, Dimension>> mean_observations_;
+    };
+}
+
+
+#include "kMeansCompressed.cpp"
+
+
+#endif  // K_MEANS_COMPRESSED_H
@@ -0,0 +1,298 @@
+/**
+ * @file kMeansDynamic.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansDynamic.
+ */
+
+
+#include "kMeansDynamic.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+cluster::kMeansDynamic<T, Distance>::
+kMeansDynamic
+(
+    size_t k, size_t dimension,
+    const T* obs, size_t n
+) :
+    kMeansBase<Sums>(k, n, k * dimension),
+    dimension_(dimension),
+    owned_observations_(obs, obs + n * dimension),
+    borrowed_observations_(nullptr),
+    mean_observations_(k * dimension)
+{
+    if (dimension == 0) { throw std::invalid_argument("dimension must be positive"); }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+cluster::kMeansDynamic<T, Distance>::
+kMeansDynamic
+(
+    size_t k, size_t dimension,
+    const T* obs, size_t n,
+    BorrowTag
+) :
+    kMeansBase<Sums>(k, n, k * dimension),
+    dimension_(dimension),
+    borrowed_observations_(obs),
+    mean_observations_(k * dimension)
+{
+    if (dimension == 0) { throw std::invalid_argument("dimension must be positive"); }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+cluster::kMeansDynamic<T, Distance>::
+kMeansDynamic
+(
+    size_t k, size_t dimension,
+    std::vector<T>&& obs
+) :
+    kMeansBase<Sums>(k, dimension == 0 ? 0 : obs.size() / dimension, k * dimension),
+    dimension_(dimension),
+    owned_observations_(std::move(obs)),
+    borrowed_observations_(nullptr),
+    mean_observations_(k * dimension)
+{
+    if (dimension == 0) { throw std::invalid_argument("dimension must be positive"); }
+    if (owned_observations_.size() % dimension != 0)
+    {
+        throw std::invalid_argument("observation count is not a whole number");
+    }
+}
+
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+void
+cluster::kMeansDynamic<T, Distance>::
+initialize(const T* means)
+{
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        set_mean(j, means + j * dimension_);
+    }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    return dispatch_assign_kernel<false>(begin, end, sizes, nullptr);
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+assign_and_sum_range
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums& sums
+)
+{
+    return dispatch_assign_kernel<true>(begin, end, sizes, &sums);
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+template<bool IsSumming>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+dispatch_assign_kernel
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums* sums
+)
+{
+    switch (dimension_)
+    {
+        case 1:   return assign_kernel<1, IsSumming>(begin, end, sizes, sums);
+        case 2:   return assign_kernel<2, IsSumming>(begin, end, sizes, sums);
+        case 3:   return assign_kernel<3, IsSumming>(begin, end, sizes, sums);
+        case 4:   return assign_kernel<4, IsSumming>(begin, end, sizes, sums);
+        case 8:   return assign_kernel<8, IsSumming>(begin, end, sizes, sums);
+        default:
+            return dispatch_wide_assign_kernel<IsSumming>(begin, end, sizes, sums, 
+                                                          std::is_same<T, float>());
+    }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+template<bool IsSumming>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+dispatch_wide_assign_kernel
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums* sums,
+    std::true_type
+)
+{
+    // wide float distances run the simd kernels, whatever the kernel's width
+    return assign_kernel<0, IsSumming>(begin, end, sizes, sums);
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+template<bool IsSumming>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+dispatch_wide_assign_kernel
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums* sums,
+    std::false_type
+)
+{
+    switch (dimension_)
+    {
+        case 16:  return assign_kernel<16, IsSumming>(begin, end, sizes, sums);
+        case 32:  return assign_kernel<32, IsSumming>(begin, end, sizes, sums);
+        case 64:  return assign_kernel<64, IsSumming>(begin, end, sizes, sums);
+        case 128: return assign_kernel<128, IsSumming>(begin, end, sizes, sums);
+        case 256: return assign_kernel<256, IsSumming>(begin, end, sizes, sums);
+        case 384: return assign_kernel<384, IsSumming>(begin, end, sizes, sums);
+        case 512: return assign_kernel<512, IsSumming>(begin, end, sizes, sums);
+        case 768: return assign_kernel<768, IsSumming>(begin, end, sizes, sums);
+        default:  return assign_kernel<0, IsSumming>(begin, end, sizes, sums);
+    }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+template<size_t FixedDimension, bool IsSumming>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+assign_kernel
+(
+    const size_t begin, const size_t end,
+    std::vector<double>& sizes, Sums* sums
+)
+{
+    // a constant dimension lets the compiler unroll and vectorize the
+    // distance loop once Distance is inlined
+    const size_t dimension = FixedDimension != 0 ? FixedDimension : dimension_;
+    const size_t k = this->k();
+    const bool is_weighted = this->is_weighted();
+    const T* observations = borrowed_observations_ != nullptr ?
+                            borrowed_observations_ :
+                            owned_observations_.data();
+    const T* means = mean_observations_.data();
+
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const T* obs = observations + i * dimension;
+        size_t nearest_mean_index = 0;
+        float nearest_mean_distance = Distance(obs, means, dimension);
+        for (size_t j = 1; j < k; ++j)
+        {
+            const float distance_to_j = Distance(obs, means + j * dimension, dimension);
+            if (distance_to_j < nearest_mean_distance)
+            {
+                nearest_mean_index = j;
+                nearest_mean_distance = distance_to_j;
+            }
+        }
+        if (this->assigned_clusters_[i] != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_[i] = nearest_mean_index;
+        this->distances_[i] = nearest_mean_distance;
+        const float weight = is_weighted ? this->weights_[i] : 1.0f;
+        sizes[nearest_mean_index] += weight;
+        if (IsSumming)
+        {
+            T* sum = &(*sums)[nearest_mean_index * dimension];
+            if (!is_weighted)
+            {
+                for (size_t d = 0; d < dimension; ++d) { sum[d] += obs[d]; }
+            }
+            else
+            {
+                for (size_t d = 0; d < dimension; ++d)
+                {
+                    sum[d] += static_cast<T>(obs[d] * weight);
+                }
+            }
+        }
+    }
+    return reassigned_count;
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+void
+cluster::kMeansDynamic<T, Distance>::
+update_range(const size_t begin, const size_t end, Sums& sums) const
+{
+    const bool is_weighted = this->is_weighted();
+    for (size_t i = begin; i < end; ++i)
+    {
+        const T* obs = observation(i);
+        T* sum = &sums[this->assigned_clusters_[i] * dimension_];
+        if (!is_weighted)
+        {
+            for (size_t d = 0; d < dimension_; ++d) { sum[d] += obs[d]; }
+        }
+        else
+        {
+            const float weight = this->weights_[i];
+            for (size_t d = 0; d < dimension_; ++d)
+            {
+                sum[d] += static_cast<T>(obs[d] * weight);
+            }
+        }
+    }
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+void
+cluster::kMeansDynamic<T, Distance>::
+set_mean_from_sums(const size_t index, const Sums& sums)
+{
+    const float scale = 1.0f / static_cast<float>(this->cluster_size(index));
+    const T* sum = &sums[index * dimension_];
+    std::vector<T> mean(dimension_);
+    for (size_t d = 0; d < dimension_; ++d)
+    {
+        mean[d] = static_cast<T>(sum[d] * scale);
+    }
+    set_mean(index, mean.data());
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+void
+cluster::kMeansDynamic<T, Distance>::
+set_mean_to_observation(const size_t index, const size_t observation_index)
+{
+    set_mean(index, observation(observation_index));
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+void
+cluster::kMeansDynamic<T, Distance>::
+set_mean(const size_t index, const T* mean)
+{
+    T* current = &mean_observations_[index * dimension_];
+    this->mean_shift_ = std::max(this->mean_shift_, Distance(current, mean, dimension_));
+    std::copy_n(mean, dimension_, current);
+}
+
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+const T*
+cluster::kMeansDynamic<T, Distance>::
+observation(const size_t index) const
+{
+    if (index >= this->n())
+    {
+        throw std::out_of_range("observation index out of range");
+    }
+    return (borrowed_observations_ != nullptr ?
+            borrowed_observations_ :
+            owned_observations_.data()) + index * dimension_;
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+const T*
+cluster::kMeansDynamic<T, Distance>::
+mean(const size_t index) const
+{
+    if (index >= this->k())
+    {
+        throw std::out_of_range("mean index out of range");
+    }
+    return &mean_observations_[index * dimension_];
+}
+template<typename T, cluster::DynamicDistanceFunction<T> Distance>
+size_t
+cluster::kMeansDynamic<T, Distance>::
+dimension() const
+{
+    return dimension_;
+}
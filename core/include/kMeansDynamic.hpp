@@ -0,0 +1,207 @@
+#ifndef K_MEANS_DYNAMIC_H
+#define K_MEANS_DYNAMIC_H
+/**
+ * @file kMeansDynamic.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansDynamic.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <type_traits>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means over observations whose dimension is known only at run time.
+     *
+     * @details
+     *  Observations and means are stored as contiguous row-major arrays of
+     *  n * dimension and k * dimension values. Weights, threads, 
+     *  tolerances and empty-cluster repair are those of kMeans, 
+     *  @see kMeansBase.
+     *
+     *  Each assigned range dispatches once to a kernel compiled for the 
+     *  dimension, so that its distance loops have a constant trip count. 
+     *  Kernels exist for dimensions 1-4 and 8, and for other than float 
+     *  data also for 16, 32, 64, 128, 256, 384, 512 and 768; other 
+     *  dimensions use a kernel with a run-time trip count. For float data, 
+     *  the built-in distances of dimension simd::MIN_DIMENSION or more run 
+     *  the vectorized kernels of simd instead.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Distance    Distance function over arrays.
+     */
+    template
+    <
+        typename NumericType,
+        DynamicDistanceFunction<NumericType> Distance
+    >
+    class kMeansDynamic : public kMeansBase<std::vector<NumericType>>
+    {
+        static_assert(std::is_arithmetic<NumericType>::value,
+                      "arithmetic type required");
+
+        public:
+        /**
+         * Initialize a new instance for given number of clusters and
+         * observation sequence.
+         *
+         * @param k            Number of clusters.
+         * @param dimension    Data dimension.
+         * @param observations Pointer to first value of the first observation,
+         *                     in row-major order.
+         * @param n            Number of observations to read from sequence.
+         *
+         * @throws std::invalid_argument If dimension is zero.
+         */
+        kMeansDynamic(size_t k, size_t dimension,
+                      const NumericType* observations, size_t n);
+        /**
+         * Initialize a new instance over a borrowed observation sequence.
+         *
+         * @details Observations are not copied.
+         *
+         * @param k            Number of clusters.
+         * @param dimension    Data dimension.
+         * @param observations Pointer to first value of the first observation,
+         *                     in row-major order.
+         * @param n            Number of observations in sequence.
+         *
+         * @pre Sequence outlives the instance and is not modified while in use.
+         *
+         * @throws std::invalid_argument If dimension is zero.
+         */
+        kMeansDynamic(size_t k, size_t dimension,
+                      const NumericType* observations, size_t n,
+                      BorrowTag);
+        /**
+         * Initialize a new instance that adopts an observation container.
+         *
+         * @details The container's storage is moved in, not copied.
+         *
+         * @param k            Number of clusters.
+         * @param dimension    Data dimension.
+         * @param observations Observations, in row-major order.
+         *
+         * @throws std::invalid_argument
+         *  If dimension is zero, or does not divide the container's size.
+         */
+        kMeansDynamic(size_t k, size_t dimension,
+                      std::vector<NumericType>&& observations);
+
+        /**
+         * Sets initial means from a sequence.
+         *
+         * @param means Pointer to first value of the first mean, in row-major
+         *              order.
+         *
+         * @pre Sequence has length >= k * dimension.
+         */
+        void initialize(const NumericType* means);
+
+        /**
+         * Gets data dimension.
+         */
+        size_t dimension() const;
+
+        /**
+         * Gets pointer to the first value of observation at index.
+         *
+         * @pre index is in [0, #(observations)).
+         */
+        const NumericType* observation(size_t index) const;
+        /**
+         * Gets pointer to the first value of mean of cluster at index.
+         *
+         * @pre index is in [0, k).
+         */
+        const NumericType* mean(size_t index) const;
+
+        protected:
+        typedef std::vector<NumericType> Sums;
+
+        /**
+         * @see kMeansBase::assign_range
+         */
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+        /**
+         * @see kMeansBase::assign_and_sum_range
+         */
+        size_t assign_and_sum_range(size_t begin, size_t end,
+                                    std::vector<double>& sizes, Sums& sums) override;
+        /**
+         * @see kMeansBase::update_range
+         */
+        void update_range(size_t begin, size_t end, Sums& sums) const override;
+        /**
+         * @see kMeansBase::set_mean_from_sums
+         */
+        void set_mean_from_sums(size_t index, const Sums& sums) override;
+        /**
+         * @see kMeansBase::set_mean_to_observation
+         */
+        void set_mean_to_observation(size_t index, size_t observation_index) override;
+
+        private:
+        /**
+         * Assigns observations in [begin, end) to clusters, optionally
+         * summing them by their new cluster.
+         *
+         * @tparam FixedDimension Dimension, or zero to use dimension().
+         * @tparam IsSumming      Whether to add observations into sums.
+         *
+         * @param sizes Per-cluster observation weights to add to.
+         * @param sums  Per-cluster sums (k * dimension) to add to.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        template<size_t FixedDimension, bool IsSumming>
+        size_t assign_kernel(size_t begin, size_t end,
+                             std::vector<double>& sizes, Sums* sums);
+        /**
+         * Calls assign_kernel() with the kernel for dimension().
+         */
+        template<bool IsSumming>
+        size_t dispatch_assign_kernel(size_t begin, size_t end,
+                                      std::vector<double>& sizes, Sums* sums);
+        /**
+         * Calls assign_kernel() for a dimension above 8.
+         *
+         * @details
+         *  Float data takes the kernel with a run-time trip count, since 
+         *  its wide distances do not inline; other data takes the kernel 
+         *  for the dimension, if there is one.
+         */
+        template<bool IsSumming>
+        size_t dispatch_wide_assign_kernel(size_t begin, size_t end,
+                                           std::vector<double>& sizes, Sums* sums,
+                                           std::true_type);
+        template<bool IsSumming>
+        size_t dispatch_wide_assign_kernel(size_t begin, size_t end,
+                                           std::vector<double>& sizes, Sums* sums,
+                                           std::false_type);
+        /**
+         * Sets mean of cluster at index.
+         *
+         * @param mean Pointer to first of dimension() values.
+         */
+        void set_mean(size_t index, const NumericType* mean);
+
+        size_t dimension_;
+        std::vector<NumericType> owned_observations_;
+        const NumericType* borrowed_observations_;
+        std::vector<NumericType> mean_observations_;
+    };
+ }
+
+
+#include "kMeansDynamic.cpp"
+
+
+#endif  // K_MEANS_DYNAMIC_H
@@ -0,0 +1,133 @@
+/**
+ * @file kMeansElkan.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansElkan.
+ */
+
+
+#include "kMeansElkan.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansElkan<T, D, Distance>::
+kMeansElkan
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeansBounded<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    upper_bounds_(this->n()),
+    lower_bounds_(this->n() * k),
+    half_mean_distances_(k * k) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansElkan<T, D, Distance>::
+prepare_bounds()
+{
+    if (this->is_bounded_) { this->compute_mean_distances(&half_mean_distances_); }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansElkan<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    const size_t k = this->k();
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Vector<T, D>& obs = this->observation(i);
+        float* lower = &lower_bounds_[i * k];
+        float& upper = upper_bounds_[i];
+        size_t nearest_mean_index = this->cluster(i);
+        
+        if (!this->is_bounded_)
+        {
+            // exhaustive search, as in kMeans
+            nearest_mean_index = 0;
+            float nearest_mean_distance = Distance(obs, this->mean(0));
+            lower[0] = std::sqrt(nearest_mean_distance);
+            for (size_t j = 1; j < k; ++j)
+            {
+                const float distance_to_j = Distance(obs, this->mean(j));
+                lower[j] = std::sqrt(distance_to_j);
+                if (distance_to_j < nearest_mean_distance)
+                {
+                    nearest_mean_index = j;
+                    nearest_mean_distance = distance_to_j;
+                }
+            }
+            upper = lower[nearest_mean_index];
+        }
+        else if (!(upper < this->half_nearest_mean_distances_[nearest_mean_index]))
+        {
+            float nearest_mean_distance = std::numeric_limits<float>::infinity();
+            bool is_upper_tight = false;
+            for (size_t j = 0; j < k; ++j)
+            {
+                if (j == nearest_mean_index ||
+                    upper < lower[j] ||
+                    upper < half_mean_distances_[nearest_mean_index * k + j])
+                {
+                    continue;
+                }
+                if (!is_upper_tight)
+                {
+                    nearest_mean_distance = Distance(obs, this->mean(nearest_mean_index));
+                    upper = lower[nearest_mean_index] = std::sqrt(nearest_mean_distance);
+                    is_upper_tight = true;
+                    if (upper < lower[j] ||
+                        upper < half_mean_distances_[nearest_mean_index * k + j])
+                    {
+                        continue;
+                    }
+                }
+                // ties are broken towards the lower index, as in kMeans
+                const float distance_to_j = Distance(obs, this->mean(j));
+                lower[j] = std::sqrt(distance_to_j);
+                if (distance_to_j < nearest_mean_distance ||
+                    (distance_to_j == nearest_mean_distance && j < nearest_mean_index))
+                {
+                    nearest_mean_index = j;
+                    nearest_mean_distance = distance_to_j;
+                    upper = lower[j];
+                }
+            }
+        }
+        if (this->assigned_clusters_.at(i) != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_.at(i) = nearest_mean_index;
+        this->distances_[i] = upper * upper;
+        sizes.at(nearest_mean_index) += this->weight(i);
+    }
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansElkan<T, D, Distance>::
+shift_bounds(const std::vector<float>& shifts)
+{
+    const size_t k = this->k();
+    parallel::for_each_range
+    (
+        this->n(), parallel::worker_count(this->n(), this->thread_count()),
+        [this, k, &shifts](size_t, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float* lower = &lower_bounds_[i * k];
+                for (size_t j = 0; j < k; ++j)
+                {
+                    lower[j] = std::max(0.0f, lower[j] - shifts[j]);
+                }
+                upper_bounds_[i] += shifts[this->cluster(i)];
+            }
+        }
+    );
+}
@@ -0,0 +1,68 @@
+#ifndef K_MEANS_ELKAN_H
+#define K_MEANS_ELKAN_H
+/**
+ * @file kMeansElkan.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansElkan.
+ */
+
+
+#include "kMeansBounded.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means accelerated by Elkan's triangle-inequality bounds.
+     *
+     * @details
+     *  Keeps an upper bound on the distance from every observation to its 
+     *  mean, a lower bound on the distance from every observation to every
+     *  mean, and the distances between all pairs of means. Distance 
+     *  computations that cannot change an assignment are skipped, and the
+     *  resulting assignments are the same as those of kMeans. 
+     *
+     *  Distance must satisfy the requirements of kMeansBounded.
+     *
+     *  Extra memory is O(n * k + k * k).
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansElkan : public kMeansBounded<NumericType, Dimension, Distance>
+    {
+        public:
+        /**
+         * @see kMeansBounded::kMeansBounded
+         */
+        template<typename... Arguments>
+        kMeansElkan(size_t k, Arguments&&... arguments);
+
+        protected:
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+        void prepare_bounds() override;
+        void shift_bounds(const std::vector<float>& shifts) override;
+
+        private:
+        std::vector<float> upper_bounds_;
+        std::vector<float> lower_bounds_;
+        std::vector<float> half_mean_distances_;
+    };
+ }
+
+
+#include "kMeansElkan.cpp"
+
+
+#endif  // K_MEANS_ELKAN_H
@@ -0,0 +1,118 @@
+/**
+ * @file kMeansGemm.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansGemm.
+ */
+
+
+#include "kMeansGemm.hpp"
+
+#include <algorithm>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansGemm<T, D, Distance>::
+kMeansGemm
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeans<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    panels_((k + simd::PANEL_WIDTH - 1) / simd::PANEL_WIDTH * simd::PANEL_WIDTH * D, 0)
+{
+    this->cache_observation_norms();
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool
+cluster::kMeansGemm<T, D, Distance>::
+assign()
+{
+    // panels past the last mean are left zero, and never selected
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        const T* mean = this->mean(j).data();
+        T* panel = &panels_[j / simd::PANEL_WIDTH * simd::PANEL_WIDTH * D];
+        for (size_t d = 0; d < D; ++d)
+        {
+            panel[d * simd::PANEL_WIDTH + j % simd::PANEL_WIDTH] = mean[d];
+        }
+    }
+    return kMeans<T, D, Distance>::assign();
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansGemm<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    const size_t k = this->k(),
+                 stride = panel_count() * simd::PANEL_WIDTH;
+    std::vector<float> cross_terms(BLOCK_SIZE * stride);
+
+    size_t reassigned_count = 0;
+    for (size_t block_begin = begin; block_begin < end; block_begin += BLOCK_SIZE)
+    {
+        const size_t block_end = std::min(block_begin + BLOCK_SIZE, end);
+        std::fill(cross_terms.begin(), cross_terms.end(), 0.0f);
+
+        // each slice of a panel is reused by every observation of the block
+        for (size_t depth_begin = 0; depth_begin < D; depth_begin += DEPTH)
+        {
+            const size_t depth_end = std::min(depth_begin + DEPTH, D);
+            for (size_t p = 0; p < panel_count(); ++p)
+            {
+                const T* panel = &panels_[p * simd::PANEL_WIDTH * D];
+                for (size_t i = block_begin; i < block_end; i += simd::PANEL_ROW_COUNT)
+                {
+                    // rows past the block's end repeat its last observation
+                    const T* rows[simd::PANEL_ROW_COUNT];
+                    for (size_t r = 0; r < simd::PANEL_ROW_COUNT; ++r)
+                    {
+                        rows[r] = this->observation(std::min(i + r, block_end - 1)).data();
+                    }
+                    float* products = &cross_terms[(i - block_begin) * stride + 
+                                                   p * simd::PANEL_WIDTH];
+                    simd::multiply_panel(rows, panel, depth_begin, depth_end, 
+                                         products, stride);
+                }
+            }
+        }
+
+        for (size_t i = block_begin; i < block_end; ++i)
+        {
+            const float* row = &cross_terms[(i - block_begin) * stride];
+            const float norm = this->observation_norm(i);
+            size_t nearest_mean_index = 0;
+            float nearest_mean_distance = norm - 2 * row[0] + this->mean_norm(0);
+            for (size_t j = 1; j < k; ++j)
+            {
+                const float distance_to_j = norm - 2 * row[j] + this->mean_norm(j);
+                if (distance_to_j < nearest_mean_distance)
+                {
+                    nearest_mean_index = j;
+                    nearest_mean_distance = distance_to_j;
+                }
+            }
+            size_t& assigned = this->assigned_clusters_.at(i);
+            if (assigned != nearest_mean_index) { ++ reassigned_count; }
+            assigned = nearest_mean_index;
+            // the expansion only ranks the means; one direct distance, a 
+            // k-th of the cross terms' work, keeps distance() and inertia() 
+            // exact where the terms nearly cancel
+            this->distances_[i] = Distance(this->observation(i), 
+                                           this->mean(nearest_mean_index));
+            sizes.at(nearest_mean_index) += this->weight(i);
+        }
+    }
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansGemm<T, D, Distance>::
+panel_count() const
+{
+    return (this->k() + simd::PANEL_WIDTH - 1) / simd::PANEL_WIDTH;
+}
@@ -0,0 +1,99 @@
+#ifndef K_MEANS_GEMM_H
+#define K_MEANS_GEMM_H
+/**
+ * @file kMeansGemm.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansGemm.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means whose assignment step is a blocked matrix multiplication.
+     *
+     * @details
+     *  Squared Euclidean distances are expanded as
+     *  |x|^2 - 2 x.c + |c|^2, with the observation norms cached on 
+     *  construction. The cross terms of a block of observations with all 
+     *  means are computed as in SGEMM:
+     *  means are packed into panels of simd::PANEL_WIDTH, stored dimension 
+     *  by dimension, and simd::multiply_panel() multiplies a few 
+     *  observations by one panel at a time, over cache-sized slices of 
+     *  DEPTH dimensions.
+     *
+     *  Pays off for high dimensions, from 64 or so. The expansion rounds
+     *  differently than distance::euclidean2, so observations that are
+     *  nearly equidistant from two means may be assigned differently than
+     *  by kMeans. The distance to the assigned mean is then computed 
+     *  directly, so distance(i) and inertia() are exact.
+     *
+     * @tparam NumericType Data type, float.
+     * @tparam Dimension   Data dimension.
+     */
+    template
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansGemm : public kMeans<NumericType, Dimension, Distance>
+    {
+        static_assert(std::is_same<NumericType, float>::value,
+                      "matrix multiplication requires float data");
+        static_assert(distance::is_euclidean2<NumericType, Dimension, Distance>::value,
+                      "matrix multiplication requires distance::euclidean2");
+
+        public:
+        /**
+         * Number of observations in a block that shares cross-term storage.
+         */
+        static const size_t BLOCK_SIZE = 64;
+        /**
+         * Number of dimensions in a slice of a panel, sized to stay in cache.
+         */
+        static const size_t DEPTH = 256;
+
+        /**
+         * @see kMeans::kMeans
+         *
+         * @details
+         *  Accepts the arguments of any kMeans constructor.
+         */
+        template<typename... Arguments>
+        kMeansGemm(size_t k, Arguments&&... arguments);
+
+        /**
+         * @see kMeans::assign
+         *
+         * @details Packs the means into panels, once per call.
+         */
+        bool assign() override;
+
+        protected:
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+
+        private:
+        /**
+         * Gets number of packed panels.
+         */
+        size_t panel_count() const;
+
+        std::vector<NumericType> panels_;
+    };
+ }
+
+
+#include "kMeansGemm.cpp"
+
+
+#endif  // K_MEANS_GEMM_H
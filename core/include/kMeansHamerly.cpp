@@ -0,0 +1,126 @@
+/**
+ * @file kMeansHamerly.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansHamerly.
+ */
+
+
+#include "kMeansHamerly.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansHamerly<T, D, Distance>::
+kMeansHamerly
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeansBounded<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    upper_bounds_(this->n()),
+    lower_bounds_(this->n()) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansHamerly<T, D, Distance>::
+prepare_bounds()
+{
+    if (this->is_bounded_) { this->compute_mean_distances(nullptr); }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansHamerly<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Vector<T, D>& obs = this->observation(i);
+        float& upper = upper_bounds_[i];
+        float& lower = lower_bounds_[i];
+        size_t nearest_mean_index = this->cluster(i);
+
+        bool is_search_required = !this->is_bounded_;
+        if (this->is_bounded_)
+        {
+            const float bound = std::max(this->half_nearest_mean_distances_[nearest_mean_index], 
+                                         lower);
+            if (!(upper < bound))
+            {
+                upper = this->metric(obs, this->mean(nearest_mean_index));
+                is_search_required = !(upper < bound);
+            }
+        }
+        if (is_search_required)
+        {
+            // exhaustive search, as in kMeans
+            nearest_mean_index = 0;
+            float nearest_mean_distance = Distance(obs, this->mean(0));
+            float second_nearest_mean_distance = std::numeric_limits<float>::infinity();
+            for (size_t j = 1; j < this->k(); ++j)
+            {
+                const float distance_to_j = Distance(obs, this->mean(j));
+                if (distance_to_j < nearest_mean_distance)
+                {
+                    second_nearest_mean_distance = nearest_mean_distance;
+                    nearest_mean_index = j;
+                    nearest_mean_distance = distance_to_j;
+                }
+                else if (distance_to_j < second_nearest_mean_distance)
+                {
+                    second_nearest_mean_distance = distance_to_j;
+                }
+            }
+            upper = std::sqrt(nearest_mean_distance);
+            lower = std::sqrt(second_nearest_mean_distance);
+        }
+        if (this->assigned_clusters_.at(i) != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_.at(i) = nearest_mean_index;
+        this->distances_[i] = upper * upper;
+        sizes.at(nearest_mean_index) += this->weight(i);
+    }
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansHamerly<T, D, Distance>::
+shift_bounds(const std::vector<float>& shifts)
+{
+    // lower bounds drop by the largest shift among the other means
+    size_t largest_shift_index = 0;
+    float largest_shift = 0.0f, second_largest_shift = 0.0f;
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        if (shifts[j] > largest_shift)
+        {
+            second_largest_shift = largest_shift;
+            largest_shift_index = j;
+            largest_shift = shifts[j];
+        }
+        else if (shifts[j] > second_largest_shift)
+        {
+            second_largest_shift = shifts[j];
+        }
+    }
+    parallel::for_each_range
+    (
+        this->n(), parallel::worker_count(this->n(), this->thread_count()),
+        [&](size_t, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const size_t cls = this->cluster(i);
+                upper_bounds_[i] += shifts[cls];
+                lower_bounds_[i] -= cls == largest_shift_index ? 
+                                    second_largest_shift : 
+                                    largest_shift;
+            }
+        }
+    );
+}
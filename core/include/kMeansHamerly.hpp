@@ -0,0 +1,68 @@
+#ifndef K_MEANS_HAMERLY_H
+#define K_MEANS_HAMERLY_H
+/**
+ * @file kMeansHamerly.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansHamerly.
+ */
+
+
+#include "kMeansBounded.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means accelerated by Hamerly's triangle-inequality bounds.
+     *
+     * @details
+     *  Keeps an upper bound on the distance from every observation to its 
+     *  mean, and a single lower bound on the distance from every observation
+     *  to its second nearest mean. Observations whose bounds prove their 
+     *  assignment cannot change are skipped, and the resulting assignments 
+     *  are the same as those of kMeans. 
+     *
+     *  Distance must satisfy the requirements of kMeansBounded.
+     *
+     *  Extra memory is O(n + k). Prefer kMeansElkan when n * k bounds fit 
+     *  in memory and k is large.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansHamerly : public kMeansBounded<NumericType, Dimension, Distance>
+    {
+        public:
+        /**
+         * @see kMeansBounded::kMeansBounded
+         */
+        template<typename... Arguments>
+        kMeansHamerly(size_t k, Arguments&&... arguments);
+
+        protected:
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+        void prepare_bounds() override;
+        void shift_bounds(const std::vector<float>& shifts) override;
+
+        private:
+        std::vector<float> upper_bounds_;
+        std::vector<float> lower_bounds_;
+    };
+ }
+
+
+#include "kMeansHamerly.cpp"
+
+
+#endif  // K_MEANS_HAMERLY_H
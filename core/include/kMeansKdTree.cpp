@@ -0,0 +1,324 @@
+/**
+ * @file kMeansKdTree.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansKdTree.
+ */
+
+
+#include "kMeansKdTree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansKdTree<T, D, Distance>::
+kMeansKdTree
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeans<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    indices_(this->n()),
+    depth_(0)
+{
+    std::iota(indices_.begin(), indices_.end(), 0);
+    if (this->n() > 0) 
+    {
+        nodes_.reserve(2 * (this->n() / LEAF_SIZE + 1));
+        build(0, this->n(), 0); 
+        set_node_sums(0);
+    }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansKdTree<T, D, Distance>::
+set_weights(const float* weights)
+{
+    kMeans<T, D, Distance>::set_weights(weights);
+    if (!nodes_.empty()) { set_node_sums(0); }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool 
+cluster::kMeansKdTree<T, D, Distance>::
+assign()
+{
+    this->mean_shift_ = 0;
+    const size_t k = this->k();
+    std::vector<size_t> candidates(k);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    
+    // expand the top of the tree so every worker has subtrees to filter
+    std::vector<size_t> frontier;
+    if (!nodes_.empty()) { frontier.push_back(0); }
+    const size_t workers = parallel::worker_count(this->n(), this->thread_count());
+    while (frontier.size() < workers)
+    {
+        std::vector<size_t> expanded;
+        for (const size_t node_index : frontier)
+        {
+            const Node& node = nodes_[node_index];
+            if (node.left == 0) { expanded.push_back(node_index); }
+            else
+            {
+                expanded.push_back(node.left);
+                expanded.push_back(node.right);
+            }
+        }
+        if (expanded.size() == frontier.size()) { break; }
+        frontier.swap(expanded);
+    }
+
+    const size_t frontier_workers = parallel::worker_count(frontier.size(), workers);
+    std::vector<std::vector<Vector<T, D>>> partial_sums(frontier_workers);
+    std::vector<std::vector<double>> partial_sizes(frontier_workers);
+    std::vector<size_t> partial_counts(frontier_workers, 0);
+    std::vector<double> partial_inertias(frontier_workers, 0);
+    parallel::for_each_range
+    (
+        frontier.size(), frontier_workers,
+        [&](const size_t worker, const size_t begin, const size_t end)
+        {
+            partial_sums[worker].resize(k);
+            partial_sizes[worker].resize(k, 0);
+            // one candidate list per tree level, reused by every node on it
+            std::vector<std::vector<size_t>> scratch(depth_ + 1);
+            for (std::vector<size_t>& level : scratch) { level.reserve(k); }
+            for (size_t i = begin; i < end; ++i)
+            {
+                partial_counts[worker] += filter(frontier[i], candidates, scratch,
+                                                 partial_sums[worker], 
+                                                 partial_sizes[worker],
+                                                 partial_inertias[worker]);
+            }
+        }
+    );
+
+    const bool is_changed = this->set_assignment(partial_sizes, partial_counts, 
+                                                 partial_inertias);
+    this->set_sums(partial_sums);
+    return is_changed;
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansKdTree<T, D, Distance>::
+set_exact_distances()
+{
+    this->compute_distances();
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansKdTree<T, D, Distance>::
+build(const size_t begin, const size_t end, const size_t depth)
+{
+    depth_ = std::max(depth_, depth);
+    const size_t node_index = nodes_.size();
+    nodes_.push_back(Node());
+    {
+        Node& node = nodes_.back();
+        node.lower = node.upper = this->observation(indices_[begin]);
+        node.begin = begin;
+        node.end = end;
+        node.depth = depth;
+        node.left = node.right = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Vector<T, D>& obs = this->observation(indices_[i]);
+            for (size_t d = 0; d < D; ++d)
+            {
+                node.lower[d] = std::min(node.lower[d], obs[d]);
+                node.upper[d] = std::max(node.upper[d], obs[d]);
+            }
+        }
+    }
+    if (end - begin <= LEAF_SIZE) { return node_index; }
+
+    // split the widest side at the median
+    size_t split_dimension = 0;
+    for (size_t d = 1; d < D; ++d)
+    {
+        const Node& node = nodes_[node_index];
+        if (node.upper[d] - node.lower[d] > 
+            node.upper[split_dimension] - node.lower[split_dimension])
+        {
+            split_dimension = d;
+        }
+    }
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element
+    (
+        indices_.begin() + begin, 
+        indices_.begin() + middle, 
+        indices_.begin() + end,
+        [this, split_dimension](const size_t a, const size_t b)
+        {
+            return this->observation(a)[split_dimension] < 
+                   this->observation(b)[split_dimension];
+        }
+    );
+    const size_t left = build(begin, middle, depth + 1);
+    const size_t right = build(middle, end, depth + 1);
+    nodes_[node_index].left = left;
+    nodes_[node_index].right = right;
+    return node_index;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansKdTree<T, D, Distance>::
+set_node_sums(const size_t node_index)
+{
+    Node& node = nodes_[node_index];
+    node.sum = Vector<T, D>();
+    node.norm_sum = 0;
+    node.weight = 0;
+    if (node.left == 0)
+    {
+        for (size_t i = node.begin; i < node.end; ++i)
+        {
+            this->add_weighted(indices_[i], node.sum);
+            node.norm_sum += this->weighted_norm(indices_[i]);
+            node.weight += this->weight(indices_[i]);
+        }
+        return;
+    }
+    set_node_sums(node.left);
+    set_node_sums(node.right);
+    node.sum = nodes_[node.left].sum + nodes_[node.right].sum;
+    node.norm_sum = nodes_[node.left].norm_sum + nodes_[node.right].norm_sum;
+    node.weight = nodes_[node.left].weight + nodes_[node.right].weight;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansKdTree<T, D, Distance>::
+filter
+(
+    const size_t node_index, const std::vector<size_t>& candidates,
+    std::vector<std::vector<size_t>>& scratch,
+    std::vector<Vector<T, D>>& sums, std::vector<double>& sizes, double& inertia
+)
+{
+    const Node& node = nodes_[node_index];
+    if (candidates.size() == 1)
+    {
+        return assign_node(node, candidates.front(), sums, sizes, inertia);
+    }
+    if (node.left == 0)
+    {
+        // ties are broken towards the lower index, as in kMeans
+        size_t reassigned_count = 0;
+        for (size_t i = node.begin; i < node.end; ++i)
+        {
+            const size_t observation_index = indices_[i];
+            const Vector<T, D>& obs = this->observation(observation_index);
+            size_t nearest_mean_index = candidates.front();
+            float nearest_mean_distance = Distance(obs, this->mean(nearest_mean_index));
+            for (size_t c = 1; c < candidates.size(); ++c)
+            {
+                const size_t j = candidates[c];
+                const float distance_to_j = Distance(obs, this->mean(j));
+                if (distance_to_j < nearest_mean_distance)
+                {
+                    nearest_mean_index = j;
+                    nearest_mean_distance = distance_to_j;
+                }
+            }
+            size_t& assigned = this->assigned_clusters_.at(observation_index);
+            if (assigned != nearest_mean_index) { ++ reassigned_count; }
+            assigned = nearest_mean_index;
+            this->distances_[observation_index] = nearest_mean_distance;
+            this->add_weighted(observation_index, sums.at(nearest_mean_index));
+            sizes.at(nearest_mean_index) += this->weight(observation_index);
+            inertia += this->weight(observation_index) * nearest_mean_distance;
+        }
+        return reassigned_count;
+    }
+
+    const Vector<T, D> middle = (node.lower + node.upper).scale(0.5f);
+    size_t nearest_mean_index = candidates.front();
+    float nearest_mean_distance = Distance(middle, this->mean(nearest_mean_index));
+    for (size_t c = 1; c < candidates.size(); ++c)
+    {
+        const size_t j = candidates[c];
+        const float distance_to_j = Distance(middle, this->mean(j));
+        if (distance_to_j < nearest_mean_distance)
+        {
+            nearest_mean_index = j;
+            nearest_mean_distance = distance_to_j;
+        }
+    }
+    // children only ever see this level's list, so the list of a level 
+    // below is free to overwrite
+    std::vector<size_t>& remaining = scratch[node.depth];
+    remaining.clear();
+    for (const size_t j : candidates)
+    {
+        if (j == nearest_mean_index || !is_dominated(node, nearest_mean_index, j))
+        {
+            remaining.push_back(j);
+        }
+    }
+    if (remaining.size() == 1)
+    {
+        return assign_node(node, nearest_mean_index, sums, sizes, inertia);
+    }
+    return filter(node.left, remaining, scratch, sums, sizes, inertia) + 
+           filter(node.right, remaining, scratch, sums, sizes, inertia);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansKdTree<T, D, Distance>::
+assign_node
+(
+    const Node& node, const size_t cluster_index,
+    std::vector<Vector<T, D>>& sums, std::vector<double>& sizes, double& inertia
+)
+{
+    // observations get the distance to the box's farthest point, an upper 
+    // bound that costs no pass over them; the inertia is exact
+    const Vector<T, D>& mean = this->mean(cluster_index);
+    float farthest_distance = 0;
+    for (size_t d = 0; d < D; ++d)
+    {
+        const float value = static_cast<float>(mean[d]);
+        const float difference = std::max(std::abs(value - static_cast<float>(node.lower[d])),
+                                          std::abs(static_cast<float>(node.upper[d]) - value));
+        farthest_distance += difference * difference;
+    }
+
+    size_t reassigned_count = 0;
+    for (size_t i = node.begin; i < node.end; ++i)
+    {
+        size_t& assigned = this->assigned_clusters_.at(indices_[i]);
+        if (assigned != cluster_index) { ++ reassigned_count; }
+        assigned = cluster_index;
+        this->distances_[indices_[i]] = farthest_distance;
+    }
+    sums.at(cluster_index) += node.sum;
+    sizes.at(cluster_index) += node.weight;
+    inertia += std::max(0.0, this->expanded_inertia(node.norm_sum, node.sum, 
+                                                    node.weight, mean));
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool
+cluster::kMeansKdTree<T, D, Distance>::
+is_dominated(const Node& node, const size_t nearer, const size_t farther) const
+{
+    // the box vertex extreme in the direction (farther - nearer) is the 
+    // point of the box most favourable to the farther mean
+    const Vector<T, D>& a = this->mean(nearer);
+    const Vector<T, D>& b = this->mean(farther);
+    Vector<T, D> vertex;
+    for (size_t d = 0; d < D; ++d)
+    {
+        vertex[d] = b[d] > a[d] ? node.upper[d] : node.lower[d];
+    }
+    return Distance(vertex, b) > Distance(vertex, a);
+}
@@ -0,0 +1,155 @@
+#ifndef K_MEANS_KD_TREE_H
+#define K_MEANS_KD_TREE_H
+/**
+ * @file kMeansKdTree.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansKdTree.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means accelerated by Kanungo et al.'s kd-tree filtering algorithm.
+     *
+     * @details
+     *  A kd-tree over the observations is built once, on construction. Each 
+     *  node stores the bounding box, weighted sum and total weight of the 
+     *  observations below
+     *  it. assign() walks the tree with a shrinking set of candidate means, 
+     *  pruning candidates that are farther than another candidate from the 
+     *  node's entire box. Once a single candidate remains, the whole subtree 
+     *  is assigned to it at once, and its stored sum is added to that mean.
+     *  update() then computes the means from these sums without another 
+     *  pass over the observations.
+     *
+     *  Observations assigned with a whole subtree report the distance to 
+     *  the farthest point of its box as distance(i), an upper bound. 
+     *  inertia() is exact: each node also stores the weighted sum of 
+     *  squared norms below it, @see kMeans::expanded_inertia.
+     *
+     *  Best suited to low-dimensional data. Candidates are pruned only when
+     *  strictly farther, so assignments are the same as those of kMeans.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansKdTree : public kMeans<NumericType, Dimension, Distance>
+    {
+        static_assert(distance::is_euclidean2<NumericType, Dimension, Distance>::value, 
+                      "kd-tree filtering requires distance::euclidean2");
+
+        public:
+        /**
+         * @see kMeans::kMeans
+         *
+         * @details 
+         *  Accepts the arguments of any kMeans constructor. Builds the kd-tree 
+         *  in O(n log n).
+         */
+        template<typename... Arguments>
+        kMeansKdTree(size_t k, Arguments&&... arguments);
+
+        /**
+         * @see kMeans::set_weights
+         *
+         * @details Recomputes the sums stored in the tree, in O(n).
+         */
+        void set_weights(const float* weights) override;
+
+        /**
+         * @see kMeans::assign
+         */
+        bool assign() override;
+
+        protected:
+        /**
+         * @see kMeansBase::set_exact_distances
+         */
+        void set_exact_distances() override;
+
+        private:
+        /**
+         * Maximum number of observations in a leaf.
+         */
+        static const size_t LEAF_SIZE = 8;
+
+        struct Node
+        {
+            Vector<NumericType, Dimension> lower;
+            Vector<NumericType, Dimension> upper;
+            Vector<NumericType, Dimension> sum;
+            double norm_sum;
+            double weight;
+            size_t begin, end;
+            size_t depth;
+            size_t left, right;  // zero for leaves
+        };
+
+        /**
+         * Builds the subtree over observations [begin, end) of indices_,
+         * rooted at the given depth.
+         *
+         * @returns Index of the subtree's root node.
+         */
+        size_t build(size_t begin, size_t end, size_t depth);
+        /**
+         * Sets the sums, norm sums and weights of the subtree rooted at node 
+         * index.
+         */
+        void set_node_sums(size_t node_index);
+
+        /**
+         * Assigns observations below a node to clusters.
+         *
+         * @param candidates Indices of candidate means, in ascending order.
+         * @param scratch    One candidate list per tree level, to reuse.
+         * @param sums       Per-cluster sums to add to.
+         * @param sizes      Per-cluster observation weights to add to.
+         * @param inertia    Weighted sum of distances to add to.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        size_t filter(size_t node_index, const std::vector<size_t>& candidates,
+                      std::vector<std::vector<size_t>>& scratch,
+                      std::vector<Vector<NumericType, Dimension>>& sums,
+                      std::vector<double>& sizes, double& inertia);
+        /**
+         * Assigns all observations below a node to a single cluster.
+         *
+         * @returns Number of observations whose cluster changed.
+         */
+        size_t assign_node(const Node& node, size_t cluster_index,
+                           std::vector<Vector<NumericType, Dimension>>& sums,
+                           std::vector<double>& sizes, double& inertia);
+        /**
+         * Checks whether every point in a node's box is strictly nearer to 
+         * one mean than to another.
+         */
+        bool is_dominated(const Node& node, size_t nearer, size_t farther) const;
+
+        std::vector<size_t> indices_;
+        std::vector<Node> nodes_;
+        size_t depth_;
+    };
+ }
+
+
+#include "kMeansKdTree.cpp"
+
+
+#endif  // K_MEANS_KD_TREE_H
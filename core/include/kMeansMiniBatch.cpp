@@ -0,0 +1,111 @@
+/**
+ * @file kMeansMiniBatch.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansMiniBatch.
+ */
+
+
+#include "kMeansMiniBatch.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansMiniBatch<T, D, Distance>::
+kMeansMiniBatch
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeans<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    batch_size_(1024),
+    step_count_(0),
+    learning_counts_(k, 0) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansMiniBatch<T, D, Distance>::
+initialize(const Vector<T, D>* means)
+{
+    kMeans<T, D, Distance>::initialize(means);
+    step_count_ = 0;
+    std::fill_n(learning_counts_.begin(), this->k(), 0);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansMiniBatch<T, D, Distance>::
+set_batch_size(const size_t size)
+{
+    batch_size_ = std::max<size_t>(1, size);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansMiniBatch<T, D, Distance>::
+step()
+{
+    this->mean_shift_ = 0;
+    ++ step_count_;
+    // nothing to sample from
+    if (this->n() == 0) { return; }
+
+    batch_.resize(batch_size_);
+    batch_clusters_.resize(batch_size_);
+    // each worker draws its part of the batch from its own stream
+    const size_t workers = parallel::worker_count(batch_size_, this->thread_count());
+    std::vector<random::Engine> engines = random::streams(workers);
+    parallel::for_each_range
+    (
+        batch_size_, workers,
+        [this, &engines](const size_t worker, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                batch_[i] = random::int_in_range<size_t>(engines[worker], 0, this->n() - 1);
+                float distance;
+                batch_clusters_[i] = this->nearest_mean(this->observation(batch_[i]), 
+                                                        distance);
+            }
+        }
+    );
+    for (size_t i = 0; i < batch_size_; ++i)
+    {
+        const size_t cls = batch_clusters_[i];
+        const float weight = this->weight(batch_[i]);
+        learning_counts_[cls] += weight;
+        if (weight == 0) { continue; }
+        const float learning_rate = weight / static_cast<float>(learning_counts_[cls]);
+        Vector<T, D> mean = this->mean(cls);
+        this->set_mean(cls, mean.scale(1.0f - learning_rate) + 
+                            Vector<T, D>(this->observation(batch_[i])).scale(learning_rate));
+    }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansMiniBatch<T, D, Distance>::
+run_steps(const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        step();
+    }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansMiniBatch<T, D, Distance>::
+batch_size() const
+{
+    return batch_size_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansMiniBatch<T, D, Distance>::
+step_count() const
+{
+    return step_count_;
+}
@@ -0,0 +1,109 @@
+#ifndef K_MEANS_MINI_BATCH_H
+#define K_MEANS_MINI_BATCH_H
+/**
+ * @file kMeansMiniBatch.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansMiniBatch.
+ */
+
+
+#include "kMeans.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Mini-batch k-means.
+     *
+     * @details
+     *  Instead of full passes over all observations, each step samples a 
+     *  batch of observations, assigns them to their nearest means, and moves 
+     *  each of those means towards its observations with a per-mean learning 
+     *  rate of w / (total weight of observations it has seen), for an 
+     *  observation of weight w; 1 / #(observations it has seen) without 
+     *  weights.
+     *
+     *  Steps update means only. Call assign() afterwards to assign all
+     *  observations to clusters. Full Lloyd iterations through assign(), 
+     *  update() and run() remain available, e.g. for refinement.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansMiniBatch : public kMeans<NumericType, Dimension, Distance>
+    {
+        public:
+        /**
+         * @see kMeans::kMeans
+         *
+         * @details Accepts the arguments of any kMeans constructor.
+         */
+        template<typename... Arguments>
+        kMeansMiniBatch(size_t k, Arguments&&... arguments);
+
+        /**
+         * @see kMeans::initialize
+         *
+         * @details Also resets learning rates and the step count.
+         */
+        void initialize(const Vector<NumericType, Dimension>* means) override;
+
+        /**
+         * Sets number of observations sampled per step.
+         *
+         * @param size Batch size > 0. Default is 1024.
+         */
+        void set_batch_size(size_t size);
+
+        /**
+         * Performs a single mini-batch step.
+         *
+         * @details
+         *  Observations are sampled uniformly, with replacement. The batch is 
+         *  assigned by worker threads as set by set_thread_count(). 
+         *  Afterwards mean_shift() is the largest distance a mean moved 
+         *  during this step. Without observations, the step does nothing.
+         */
+        void step();
+
+        /**
+         * Performs mini-batch steps.
+         *
+         * @param count Number of steps to perform.
+         */
+        void run_steps(size_t count);
+
+        /**
+         * Gets number of observations sampled per step.
+         */
+        size_t batch_size() const;
+        /**
+         * Gets number of steps performed since initialization.
+         */
+        size_t step_count() const;
+
+        private:
+        size_t batch_size_;
+        size_t step_count_;
+        std::vector<size_t> batch_;
+        std::vector<size_t> batch_clusters_;
+        std::vector<double> learning_counts_;
+    };
+ }
+
+
+#include "kMeansMiniBatch.cpp"
+
+
+#endif  // K_MEANS_MINI_BATCH_H
@@ -0,0 +1,120 @@
+/**
+ * @file kMeansOnline.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansOnline.
+ */
+
+
+#include "kMeansOnline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+cluster::kMeansOnline<T, D, Distance>::
+kMeansOnline(size_t k) : 
+    mean_observations_(k),
+    cluster_sizes_(k, 0),
+    initialized_mean_count_(0),
+    observation_count_(0)
+{
+    // every observation is assigned to a mean
+    if (k == 0) { throw std::invalid_argument("k must be positive"); }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansOnline<T, D, Distance>::
+initialize(const Vector<T, D>* means)
+{
+    for (size_t i = 0; i < k(); ++i)
+    {
+        mean_observations_.at(i) = means[i];
+    }
+    // each seed counts as one observation, as in MacQueen's method, so the 
+    // first observation assigned to a mean does not overwrite it
+    std::fill_n(cluster_sizes_.begin(), k(), 1);
+    initialized_mean_count_ = k();
+    observation_count_ = 0;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansOnline<T, D, Distance>::
+observe(const Vector<T, D>& obs)
+{
+    ++ observation_count_;
+    if (!is_initialized())
+    {
+        const size_t cls = initialized_mean_count_ ++;
+        mean_observations_.at(cls) = obs;
+        cluster_sizes_.at(cls) = 1;
+        return cls;
+    }
+
+    size_t nearest_mean_index = 0;
+    float nearest_mean_distance = Distance(obs, mean(0));
+    for (size_t j = 1; j < k(); ++j)
+    {
+        const float distance_to_j = Distance(obs, mean(j));
+        if (distance_to_j < nearest_mean_distance)
+        {
+            nearest_mean_index = j;
+            nearest_mean_distance = distance_to_j;
+        }
+    }
+    Vector<T, D>& nearest_mean = mean_observations_.at(nearest_mean_index);
+    const float learning_rate = 
+        1.0f / static_cast<float>(++ cluster_sizes_.at(nearest_mean_index));
+    nearest_mean += (Vector<T, D>(obs) - nearest_mean).scale(learning_rate);
+    return nearest_mean_index;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename InputIterator>
+void 
+cluster::kMeansOnline<T, D, Distance>::
+observe(InputIterator begin, const InputIterator end)
+{
+    for (; begin != end; ++begin)
+    {
+        observe(*begin);
+    }
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+bool 
+cluster::kMeansOnline<T, D, Distance>::
+is_initialized() const
+{
+    return initialized_mean_count_ == k();
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansOnline<T, D, Distance>::
+n() const
+{
+    return observation_count_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansOnline<T, D, Distance>::
+k() const
+{
+    return mean_observations_.size();
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansOnline<T, D, Distance>::
+cluster_size(const size_t index) const
+{
+    return cluster_sizes_.at(index);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+const cluster::Vector<T, D>&
+cluster::kMeansOnline<T, D, Distance>::
+mean(const size_t index) const
+{
+    return mean_observations_.at(index);
+}
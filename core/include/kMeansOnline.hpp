@@ -0,0 +1,122 @@
+#ifndef K_MEANS_ONLINE_H
+#define K_MEANS_ONLINE_H
+/**
+ * @file kMeansOnline.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansOnline.
+ */
+
+
+#include "distance.hpp"
+#include "Vector.hpp"
+
+#include <type_traits>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Online (MacQueen) k-means over a stream of observations.
+     *
+     * @details
+     *  Observations are consumed one at a time or in chunks and are never 
+     *  stored. Each observation is assigned to its nearest mean, which then 
+     *  moves towards it by 1 / #(observations assigned to that mean so far).
+     *  Memory use is O(k * Dimension), independent of stream length.
+     *
+     *  Unless initialize() is called, the first k observations become the 
+     *  initial means.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansOnline
+    {
+        static_assert(std::is_arithmetic<NumericType>::value, 
+                      "arithmetic type required");
+
+        public:
+        /**
+         * Initialize a new instance for given number of clusters.
+         *
+         * @param k Number of clusters.
+         *
+         * @throws std::invalid_argument If k is zero.
+         */
+        explicit kMeansOnline(size_t k);
+
+        /**
+         * Sets initial means from a sequence and restarts the observation count.
+         * Each mean starts with a cluster size of one, so that it weighs as 
+         * much as a single observation.
+         *
+         * @param means Pointer to first mean in sequence.
+         *
+         * @pre Sequence has length >= number of clusters provided in constructor.
+         */
+        void initialize(const Vector<NumericType, Dimension>* means);
+
+        /**
+         * Consumes a single observation.
+         *
+         * @returns Index of the cluster the observation is assigned to.
+         */
+        size_t observe(const Vector<NumericType, Dimension>& observation);
+        /**
+         * Consumes a chunk of observations.
+         *
+         * @tparam InputIterator Iterator type of the chunk. A single pass is made.
+         */
+        template<typename InputIterator>
+        void observe(InputIterator begin, InputIterator end);
+
+        /**
+         * Gets whether all means have been set, either by initialize() or by
+         * the first k observations.
+         */
+        bool is_initialized() const;
+        /**
+         * Gets number of observations consumed.
+         */
+        size_t n() const;
+        /**
+         * Gets number of clusters.
+         */
+        size_t k() const;
+
+        /**
+         * Gets the number of observations assigned to cluster at index,
+         * counting its initial mean as one.
+         *
+         * @pre index is in [0, k).
+         */
+        size_t cluster_size(size_t index) const;
+        /**
+         * Gets mean observation of cluster at index.
+         *
+         * @pre index is in [0, k).
+         */
+        const Vector<NumericType, Dimension>& mean(size_t index) const;
+
+        private:
+        std::vector<Vector<NumericType, Dimension>> mean_observations_;
+        std::vector<size_t> cluster_sizes_;
+        size_t initialized_mean_count_;
+        size_t observation_count_;
+    };
+ }
+
+
+#include "kMeansOnline.cpp"
+
+
+#endif  // K_MEANS_ONLINE_H
@@ -0,0 +1,232 @@
+/**
+ * @file kMeansRestarts.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansRestarts.
+ */
+
+
+#include "kMeansRestarts.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+kMeansRestarts
+(
+    const size_t k,
+    const Vector<T, D>* observations, const size_t n
+) :
+    k_(k),
+    observations_(observations),
+    observation_count_(n),
+    restart_count_(10),
+    thread_count_(0),
+    solver_thread_count_(1),
+    seeder_(nullptr),
+    parallel_seeder_(&seeder::k_means_plus_plus<T, D, const Vector<T, D>*, Vector<T, D>*>),
+    abandon_ratio_(1.1),
+    best_index_(0) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_restart_count(const size_t count)
+{
+    restart_count_ = std::max<size_t>(1, count);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_thread_count(const size_t count)
+{
+    thread_count_ = count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_solver_thread_count(const size_t count)
+{
+    solver_thread_count_ = count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_seeder(const Seeder seeder)
+{
+    seeder_ = seeder;
+    parallel_seeder_ = nullptr;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_parallel_seeder(const ParallelSeeder seeder)
+{
+    parallel_seeder_ = seeder;
+    seeder_ = nullptr;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_configuration(std::function<void(Solver&)> configure)
+{
+    configure_ = std::move(configure);
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+void
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+set_abandon_ratio(const double ratio)
+{
+    abandon_ratio_ = ratio;
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+size_t
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+run(const size_t max_iterations)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    statistics_.assign(restart_count_, Statistics{infinity, 0, false});
+    best_.reset();
+    best_index_ = 0;
+
+    const size_t workers = parallel::worker_count(restart_count_, thread_count_);
+
+    // streams are split before any restart runs, so restart r draws the 
+    // same numbers whichever worker runs it
+    const std::vector<random::Engine> engines = random::streams(restart_count_);
+    std::atomic<size_t> next_restart(0);
+    std::mutex best_mutex;
+    double best_inertia = infinity;  // guarded by best_mutex
+    parallel::for_each_range
+    (
+        workers, workers,
+        [&](size_t, size_t, size_t)
+        {
+            // workers take the next restart as they free up
+            for (size_t r = next_restart++; r < restart_count_; r = next_restart++)
+            {
+                const random::Engine thread_engine = random::engine();
+                random::engine() = engines[r];
+
+                std::unique_ptr<Solver> solver
+                (
+                    new Solver(k_, observations_, observation_count_, borrow)
+                );
+                solver->set_thread_count(solver_thread_count_);
+                if (configure_) { configure_(*solver); }
+                std::vector<Vector<T, D>> means(k_);
+                const Vector<T, D>* const end = observations_ + observation_count_;
+                if (parallel_seeder_ != nullptr)
+                {
+                    parallel_seeder_(k_, observations_, end, &means[0], solver_thread_count_);
+                }
+                else { seeder_(k_, observations_, end, &means[0]); }
+                solver->initialize(&means[0]);
+
+                Statistics& statistics = statistics_[r];
+                statistics.iterations = solver->run
+                (
+                    max_iterations,
+                    [&](const double previous_inertia)
+                    {
+                        double current_best;
+                        {
+                            std::lock_guard<std::mutex> lock(best_mutex);
+                            current_best = best_inertia;
+                        }
+                        statistics.is_abandoned = 
+                            is_behind(solver->inertia(), previous_inertia, current_best);
+                        return statistics.is_abandoned;
+                    }
+                );
+                // without iterations, the restart is ranked by its seeds
+                if (max_iterations == 0) { solver->assign(); }
+                statistics.inertia = solver->inertia();
+                random::engine() = thread_engine;
+                if (statistics.is_abandoned) { continue; }
+
+                // ties go to the lower index, whatever the finishing order
+                std::lock_guard<std::mutex> lock(best_mutex);
+                if (!best_ || 
+                    statistics.inertia < best_inertia || 
+                    (statistics.inertia == best_inertia && r < best_index_))
+                {
+                    best_inertia = statistics.inertia;
+                    best_ = std::move(solver);
+                    best_index_ = r;
+                }
+            }
+        }
+    );
+    return best_index_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+bool
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+is_behind(const double inertia, 
+          const double previous_inertia, 
+          const double best_inertia) const
+{
+    // early iterations may still improve by a lot after a small gain, so 
+    // only a restart that has all but settled is judged
+    const double settled_improvement = 0.01;
+    return abandon_ratio_ > 0 && 
+           previous_inertia < std::numeric_limits<double>::infinity() &&
+           previous_inertia - inertia <= settled_improvement * previous_inertia &&
+           inertia > abandon_ratio_ * best_inertia;
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+size_t
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+restart_count() const
+{
+    return restart_count_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+size_t
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+thread_count() const
+{
+    return thread_count_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+size_t
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+solver_thread_count() const
+{
+    return solver_thread_count_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+size_t
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+best_index() const
+{
+    return best_index_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+const Solver&
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+best() const
+{
+    if (!best_) { throw std::logic_error("no restart has run"); }
+    return *best_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance, typename Solver>
+const typename cluster::kMeansRestarts<T, D, Distance, Solver>::Statistics&
+cluster::kMeansRestarts<T, D, Distance, Solver>::
+statistics(const size_t index) const
+{
+    return statistics_.at(index);
+}
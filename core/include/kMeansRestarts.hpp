@@ -0,0 +1,226 @@
+#ifndef K_MEANS_RESTARTS_H
+#define K_MEANS_RESTARTS_H
+/**
+ * @file kMeansRestarts.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansRestarts.
+ */
+
+
+#include "kMeans.hpp"
+#include "seeder.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Runs several independently seeded solvers over the same observations 
+     * and keeps the one of least inertia.
+     *
+     * @details
+     *  Restarts run concurrently, each on its own solver borrowing the one 
+     *  observation sequence, so observations are never copied. Each restart 
+     *  draws from its own random stream, split off the calling thread's 
+     *  engine, so after random::seed() every restart follows the same 
+     *  iterations regardless of set_thread_count(), for a given 
+     *  set_solver_thread_count().
+     *
+     *  Restarts are compared on inertia(), which every solver computes 
+     *  exactly, also those whose distance() is a bound.
+     *
+     *  A restart that falls clearly behind the best finished restart is 
+     *  abandoned early, @see set_abandon_ratio. Which restarts have finished 
+     *  by then depends on timing, so abandoning is not reproducible.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     * @tparam Solver      kMeans, or a class derived from it, with a 
+     *                     constructor borrowing observations.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance,
+        typename Solver = kMeans<NumericType, Dimension, Distance>
+    >
+    class kMeansRestarts
+    {
+        public:
+        typedef SeederFunction
+        <
+            NumericType, Dimension, 
+            const Vector<NumericType, Dimension>*, 
+            Vector<NumericType, Dimension>*
+        > 
+            Seeder;
+        /**
+         * Seeder function that also takes a number of threads, such as 
+         * seeder::k_means_plus_plus().
+         */
+        typedef void (*ParallelSeeder)(size_t k, 
+                                       const Vector<NumericType, Dimension>* begin, 
+                                       const Vector<NumericType, Dimension>* end,
+                                       Vector<NumericType, Dimension>* out,
+                                       size_t thread_count);
+
+        /**
+         * Outcome of a single restart.
+         */
+        struct Statistics
+        {
+            double inertia;      // exact inertia of the last assignment
+            size_t iterations;   // iterations performed
+            bool is_abandoned;   // whether stopped for falling behind
+        };
+
+        /**
+         * Initialize a new instance for given number of clusters and 
+         * observation sequence.
+         *
+         * @details Observations are not copied.
+         *
+         * @param k            Number of clusters.
+         * @param observations Pointer to first observation in sequence.
+         * @param n            Number of observations in sequence.
+         *
+         * @pre Sequence outlives the instance and is not modified while in use.
+         */
+        kMeansRestarts(size_t k,
+                       const Vector<NumericType, Dimension>* observations, size_t n);
+
+        /**
+         * Sets number of restarts.
+         *
+         * @param count Count > 0. Default is 10.
+         */
+        void set_restart_count(size_t count);
+        /**
+         * Sets number of restarts that run concurrently.
+         *
+         * @details Does not change the outcome of any restart.
+         *
+         * @param count Number of threads. Zero selects the hardware's 
+         *              concurrency, which is the default.
+         */
+        void set_thread_count(size_t count);
+        /**
+         * Sets number of threads each restart uses for seeding and for its 
+         * solver, @see kMeansBase::set_thread_count.
+         *
+         * @details
+         *  Restarts use up to thread_count() times count threads in all. 
+         *  The count may change the means found by rounding.
+         *
+         * @param count Number of threads. Zero selects the hardware's 
+         *              concurrency. Default is one.
+         */
+        void set_solver_thread_count(size_t count);
+        /**
+         * Sets the seeder of initial means.
+         */
+        void set_seeder(Seeder seeder);
+        /**
+         * Sets the seeder of initial means, to run on each restart's 
+         * threads, @see set_solver_thread_count. Default is 
+         * seeder::k_means_plus_plus().
+         */
+        void set_parallel_seeder(ParallelSeeder seeder);
+        /**
+         * Sets a function applied to each solver before it is seeded, e.g. to 
+         * set tolerances or weights.
+         */
+        void set_configuration(std::function<void(Solver&)> configure);
+        /**
+         * Sets how far behind the best finished restart another restart may 
+         * fall before it is abandoned.
+         *
+         * @details
+         *  A restart is abandoned once an iteration improves its inertia by 
+         *  less than 1%, while its inertia still exceeds ratio times the 
+         *  best final inertia so far. Lloyd iterations only lower inertia, 
+         *  and one that has all but settled that far behind is unlikely to 
+         *  catch up.
+         *
+         * @param ratio Ratio >= 1, or zero to disable. Default is 1.1.
+         */
+        void set_abandon_ratio(double ratio);
+
+        /**
+         * Runs all restarts.
+         *
+         * @param max_iterations Maximum number of iterations per restart. 
+         *                       With zero, each restart is only assigned 
+         *                       to its seeds, and ranked by that inertia.
+         *
+         * @returns Index of the best restart.
+         */
+        size_t run(size_t max_iterations);
+
+        /**
+         * Gets number of restarts.
+         */
+        size_t restart_count() const;
+        /**
+         * Gets number of restarts that run concurrently, as set by 
+         * set_thread_count().
+         */
+        size_t thread_count() const;
+        /**
+         * Gets number of threads of each restart, as set by 
+         * set_solver_thread_count().
+         */
+        size_t solver_thread_count() const;
+        /**
+         * Gets index of the restart of least inertia, as of the last run().
+         */
+        size_t best_index() const;
+        /**
+         * Gets the solver of least inertia, as of the last run().
+         *
+         * @throws std::logic_error if run() was not called.
+         */
+        const Solver& best() const;
+        /**
+         * Gets outcome of a restart, as of the last run().
+         *
+         * @pre index is in [0, restart_count()).
+         */
+        const Statistics& statistics(size_t index) const;
+
+        private:
+        /**
+         * Checks whether a restart has all but settled clearly above the 
+         * best inertia.
+         */
+        bool is_behind(double inertia, 
+                       double previous_inertia, 
+                       double best_inertia) const;
+
+        size_t k_;
+        const Vector<NumericType, Dimension>* observations_;
+        size_t observation_count_;
+        size_t restart_count_;
+        size_t thread_count_;
+        size_t solver_thread_count_;
+        Seeder seeder_;                    // nullptr if parallel_seeder_ is set
+        ParallelSeeder parallel_seeder_;   // nullptr if seeder_ is set
+        std::function<void(Solver&)> configure_;
+        double abandon_ratio_;
+        std::unique_ptr<Solver> best_;
+        size_t best_index_;
+        std::vector<Statistics> statistics_;
+    };
+}
+
+
+#include "kMeansRestarts.cpp"
+
+
+#endif  // K_MEANS_RESTARTS_H
@@ -0,0 +1,230 @@
+/**
+ * @file kMeansYinyang.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansYinyang.
+ */
+
+
+#include "kMeansYinyang.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+template<typename... Arguments>
+cluster::kMeansYinyang<T, D, Distance>::
+kMeansYinyang
+(
+    size_t k,
+    Arguments&&... arguments
+) :
+    kMeansBounded<T, D, Distance>(k, std::forward<Arguments>(arguments)...),
+    group_count_(std::max<size_t>(1, k / 10)),
+    mean_groups_(k, 0),
+    upper_bounds_(this->n()) {}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansYinyang<T, D, Distance>::
+set_group_count(const size_t count)
+{
+    group_count_ = std::max<size_t>(1, std::min(count, this->k()));
+    this->is_bounded_ = false;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void 
+cluster::kMeansYinyang<T, D, Distance>::
+prepare_bounds()
+{
+    if (!this->is_bounded_) { group_means(); }
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t 
+cluster::kMeansYinyang<T, D, Distance>::
+assign_range(const size_t begin, const size_t end, std::vector<double>& sizes)
+{
+    const size_t t = group_count_;
+    const float infinity = std::numeric_limits<float>::infinity();
+    std::vector<char> is_group_searched(t);
+    std::vector<size_t> group_nearest_indices(t);
+    std::vector<float> group_nearest_distances(t);
+    std::vector<float> group_second_nearest_distances(t);
+
+    size_t reassigned_count = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Vector<T, D>& obs = this->observation(i);
+        float* lower = &lower_bounds_[i * t];
+        float& upper = upper_bounds_[i];
+        const size_t assigned_mean_index = this->cluster(i);
+        size_t nearest_mean_index = assigned_mean_index;
+        float nearest_mean_distance = infinity;
+        float assigned_mean_distance = infinity;
+
+        // global filter
+        if (this->is_bounded_)
+        {
+            const float global_lower = *std::min_element(lower, lower + t);
+            if (upper < global_lower) 
+            {
+                sizes.at(nearest_mean_index) += this->weight(i);
+                this->distances_[i] = upper * upper;
+                continue;
+            }
+            assigned_mean_distance = Distance(obs, this->mean(assigned_mean_index));
+            nearest_mean_distance = assigned_mean_distance;
+            upper = std::sqrt(nearest_mean_distance);
+            if (upper < global_lower)
+            {
+                sizes.at(nearest_mean_index) += this->weight(i);
+                this->distances_[i] = upper * upper;
+                continue;
+            }
+        }
+
+        // group filter
+        for (size_t g = 0; g < t; ++g)
+        {
+            is_group_searched[g] = !group_members_[g].empty() && 
+                                   (!this->is_bounded_ || !(upper < lower[g]));
+            if (!is_group_searched[g]) { continue; }
+
+            size_t group_nearest_index = 0;
+            float group_nearest_distance = infinity,
+                  group_second_nearest_distance = infinity;
+            for (const size_t j : group_members_[g])
+            {
+                const float distance_to_j = 
+                    this->is_bounded_ && j == assigned_mean_index ? 
+                    assigned_mean_distance : 
+                    Distance(obs, this->mean(j));
+                // ties are broken towards the lower index, as in kMeans
+                if (distance_to_j < group_nearest_distance ||
+                    (distance_to_j == group_nearest_distance && j < group_nearest_index))
+                {
+                    group_second_nearest_distance = group_nearest_distance;
+                    group_nearest_index = j;
+                    group_nearest_distance = distance_to_j;
+                }
+                else if (distance_to_j < group_second_nearest_distance)
+                {
+                    group_second_nearest_distance = distance_to_j;
+                }
+            }
+            group_nearest_indices[g] = group_nearest_index;
+            group_nearest_distances[g] = group_nearest_distance;
+            group_second_nearest_distances[g] = group_second_nearest_distance;
+
+            if (group_nearest_distance < nearest_mean_distance ||
+                (group_nearest_distance == nearest_mean_distance && 
+                 group_nearest_index < nearest_mean_index))
+            {
+                nearest_mean_index = group_nearest_index;
+                nearest_mean_distance = group_nearest_distance;
+                upper = std::sqrt(nearest_mean_distance);
+            }
+        }
+
+        // bounds of searched groups exclude the new mean only
+        for (size_t g = 0; g < t; ++g)
+        {
+            if (!is_group_searched[g]) { continue; }
+            lower[g] = std::sqrt
+            (
+                group_nearest_indices[g] == nearest_mean_index ? 
+                group_second_nearest_distances[g] : 
+                group_nearest_distances[g]
+            );
+        }
+        const size_t assigned_group = mean_groups_[assigned_mean_index];
+        if (this->is_bounded_ && 
+            nearest_mean_index != assigned_mean_index && 
+            !is_group_searched[assigned_group])
+        {
+            lower[assigned_group] = std::min(lower[assigned_group], 
+                                             std::sqrt(assigned_mean_distance));
+        }
+
+        if (assigned_mean_index != nearest_mean_index) { ++ reassigned_count; }
+        this->assigned_clusters_.at(i) = nearest_mean_index;
+        this->distances_[i] = upper * upper;
+        sizes.at(nearest_mean_index) += this->weight(i);
+    }
+    return reassigned_count;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansYinyang<T, D, Distance>::
+shift_bounds(const std::vector<float>& shifts)
+{
+    const size_t t = group_count_;
+    std::vector<float> group_shifts(t, 0.0f);
+    for (size_t j = 0; j < this->k(); ++j)
+    {
+        float& group_shift = group_shifts[mean_groups_[j]];
+        group_shift = std::max(group_shift, shifts[j]);
+    }
+    parallel::for_each_range
+    (
+        this->n(), parallel::worker_count(this->n(), this->thread_count()),
+        [this, t, &shifts, &group_shifts](size_t, const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float* lower = &lower_bounds_[i * t];
+                for (size_t g = 0; g < t; ++g)
+                {
+                    lower[g] -= group_shifts[g];
+                }
+                upper_bounds_[i] += shifts[this->cluster(i)];
+            }
+        }
+    );
+}
+
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansYinyang<T, D, Distance>::
+group_count() const
+{
+    return group_count_;
+}
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+size_t
+cluster::kMeansYinyang<T, D, Distance>::
+group(const size_t index) const
+{
+    return mean_groups_.at(index);
+}
+
+template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+void
+cluster::kMeansYinyang<T, D, Distance>::
+group_means()
+{
+    static const size_t GROUPING_ITERATIONS = 5;
+
+    const size_t k = this->k(), t = group_count_;
+    kMeans<T, D, Distance> grouping(t, &this->mean_observations_[0], k, borrow);
+    std::vector<Vector<T, D>> initial_group_means(t);
+    for (size_t g = 0; g < t; ++g)
+    {
+        initial_group_means[g] = this->mean(g * k / t);
+    }
+    grouping.initialize(&initial_group_means[0]);
+    grouping.run(GROUPING_ITERATIONS);
+    grouping.assign();
+
+    group_members_.assign(t, std::vector<size_t>());
+    for (size_t j = 0; j < k; ++j)
+    {
+        mean_groups_[j] = grouping.cluster(j);
+        group_members_[mean_groups_[j]].push_back(j);
+    }
+    lower_bounds_.assign(this->n() * t, std::numeric_limits<float>::infinity());
+}
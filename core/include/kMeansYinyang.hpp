@@ -0,0 +1,98 @@
+#ifndef K_MEANS_YINYANG_H
+#define K_MEANS_YINYANG_H
+/**
+ * @file kMeansYinyang.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Class kMeansYinyang.
+ */
+
+
+#include "kMeansBounded.hpp"
+
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * k-means accelerated by Yinyang's grouped triangle-inequality bounds.
+     *
+     * @details
+     *  Means are grouped once, on the first assignment after initialization,
+     *  by a small k-means over the means themselves. Every observation keeps 
+     *  an upper bound on the distance to its mean and one lower bound per 
+     *  group. Observations are filtered first against all groups at once, 
+     *  then group by group, so only groups that may hold a nearer mean are 
+     *  searched. The resulting assignments are the same as those of kMeans.
+     *
+     *  Distance must satisfy the requirements of kMeansBounded.
+     *
+     *  Extra memory is O(n * #(groups)), in between that of kMeansHamerly 
+     *  and kMeansElkan.
+     *
+     * @tparam NumericType Data type.
+     * @tparam Dimension   Data dimension.
+     */
+    template 
+    <
+        typename NumericType,
+        size_t Dimension,
+        DistanceFunction<NumericType, Dimension> Distance
+    >
+    class kMeansYinyang : public kMeansBounded<NumericType, Dimension, Distance>
+    {
+        public:
+        /**
+         * @see kMeansBounded::kMeansBounded
+         */
+        template<typename... Arguments>
+        kMeansYinyang(size_t k, Arguments&&... arguments);
+
+        /**
+         * Sets number of mean groups.
+         *
+         * @details Means are regrouped on the next call to assign().
+         *
+         * @param count Number of groups in [1, k]. Default is max(1, k / 10).
+         */
+        void set_group_count(size_t count);
+
+        /**
+         * Gets number of mean groups.
+         */
+        size_t group_count() const;
+        /**
+         * Gets group index of mean at index.
+         *
+         * @pre index is in [0, k).
+         * @pre assign() was called since the last call to initialize().
+         */
+        size_t group(size_t index) const;
+
+        protected:
+        size_t assign_range(size_t begin, size_t end, std::vector<double>& sizes) override;
+        void prepare_bounds() override;
+        void shift_bounds(const std::vector<float>& shifts) override;
+
+        private:
+        /**
+         * Partitions the means into groups with k-means.
+         */
+        void group_means();
+
+        size_t group_count_;
+        std::vector<size_t> mean_groups_;
+        std::vector<std::vector<size_t>> group_members_;
+        std::vector<float> upper_bounds_;
+        std::vector<float> lower_bounds_;
+    };
+ }
+
+
+#include "kMeansYinyang.cpp"
+
+
+#endif  // K_MEANS_YINYANG_H
@@ -0,0 +1,75 @@
+/**
+ * @file parallel.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Parallel helpers.
+ */
+
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+
+inline size_t
+cluster::parallel::hardware_thread_count()
+{
+    const size_t count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+inline size_t
+cluster::parallel::worker_count(const size_t n, const size_t thread_count)
+{
+    const size_t requested = thread_count == 0 ? 
+                             hardware_thread_count() : 
+                             thread_count;
+    return std::max<size_t>(1, std::min(requested, n));
+}
+
+template<typename Function>
+void
+cluster::parallel::for_each_range(const size_t n, const size_t worker_count, 
+                                  Function function)
+{
+    if (worker_count <= 1)
+    {
+        function(0, 0, n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i)
+    {
+        const size_t begin = n * i / worker_count,
+                     end   = n * (i + 1) / worker_count;
+        workers.emplace_back(function, i, begin, end);
+    }
+    function(0, 0, n / worker_count);
+    for (std::thread& worker : workers) { worker.join(); }
+}
+template<typename T, typename Combine>
+void
+cluster::parallel::reduce(std::vector<T>& partials, Combine combine)
+{
+    for (size_t stride = 1; stride < partials.size(); stride *= 2)
+    {
+        const size_t pair_count = (partials.size() - stride + 2 * stride - 1) / 
+                                  (2 * stride);
+        for_each_range
+        (
+            pair_count, pair_count,
+            [&partials, &combine, stride]
+            (size_t, const size_t begin, const size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    combine(partials[2 * stride * i], 
+                            partials[2 * stride * i + stride]);
+                }
+            }
+        );
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef K_MEANS_PARALLEL_H
+#define K_MEANS_PARALLEL_H
+/**
+ * @file parallel.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Parallel helpers.
+ */
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace cluster
+{
+    /**
+     * Container for parallel operations.
+     */
+    namespace parallel
+    {
+        /**
+         * Gets number of concurrent threads supported by the hardware.
+         *
+         * @returns At least one.
+         */
+        size_t hardware_thread_count();
+
+        /**
+         * Gets number of workers to use for a range of given length.
+         *
+         * @param n            Length of range.
+         * @param thread_count Requested number of workers. Zero requests
+         *                     hardware_thread_count().
+         *
+         * @returns Number of workers in [1, max(n, 1)].
+         */
+        size_t worker_count(size_t n, size_t thread_count);
+
+        /**
+         * Splits [0, n) into contiguous ranges and processes each on its own
+         * thread.
+         *
+         * @details
+         *  Function is called as function(worker_index, begin, end) for every
+         *  worker_index in [0, worker_count). The calling thread processes the
+         *  first range and returns after all ranges are done.
+         *
+         * @param n            Length of range.
+         * @param worker_count Number of ranges.
+         * @param function     Range function.
+         */
+        template<typename Function>
+        void for_each_range(size_t n, size_t worker_count, Function function);
+
+        /**
+         * Combines partial results with a tree reduction.
+         *
+         * @details
+         *  In each round, every pair of neighbouring partials is combined
+         *  on its own thread as combine(left, right), where the result is 
+         *  to be stored in left. The reduction takes ceil(log2(#partials)) 
+         *  rounds.
+         *
+         * @param partials Partial results. The total is stored in the first.
+         * @param combine  Combine function.
+         */
+        template<typename T, typename Combine>
+        void reduce(std::vector<T>& partials, Combine combine);
+    }
+}
+
+
+#include "parallel.cpp"
+
+
+#endif  // K_MEANS_PARALLEL_H
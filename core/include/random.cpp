@@ -0,0 +1,158 @@
+/**
+ * @file random.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Random helpers.
+ */
+
+
+#include "random.hpp"
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+
+namespace cluster
+{
+    namespace random
+    {
+        namespace detail
+        {
+            /**
+             * Rotates bits left.
+             */
+            inline uint64_t rotate_left(const uint64_t x, const int k)
+            {
+                return (x << k) | (x >> (64 - k));
+            }
+            /**
+             * The splitmix64 generator, for expanding a seed into a state.
+             */
+            inline uint64_t split_mix(uint64_t& x)
+            {
+                uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+        }
+    }
+}
+
+
+inline
+cluster::random::Engine::Engine(const uint64_t seed_value)
+{
+    seed(seed_value);
+}
+inline void
+cluster::random::Engine::seed(uint64_t seed_value)
+{
+    for (uint64_t& word : state_) { word = detail::split_mix(seed_value); }
+}
+inline cluster::random::Engine::result_type
+cluster::random::Engine::operator()()
+{
+    const uint64_t result = detail::rotate_left(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = detail::rotate_left(state_[3], 45);
+    return result;
+}
+inline void
+cluster::random::Engine::jump()
+{
+    static const uint64_t JUMP[4]
+    {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 
+        0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+    uint64_t jumped[4] { 0, 0, 0, 0 };
+    for (const uint64_t word : JUMP)
+    {
+        for (int bit = 0; bit < 64; ++bit)
+        {
+            if (word & (static_cast<uint64_t>(1) << bit))
+            {
+                for (size_t i = 0; i < 4; ++i) { jumped[i] ^= state_[i]; }
+            }
+            (*this)();
+        }
+    }
+    for (size_t i = 0; i < 4; ++i) { state_[i] = jumped[i]; }
+}
+
+inline cluster::random::Engine&
+cluster::random::engine()
+{
+    #ifdef _DEBUG
+    thread_local Engine thread_engine;  // use default seed
+    #else
+    thread_local Engine thread_engine
+    (
+        (static_cast<uint64_t>(std::random_device()()) << 32) ^ 
+        std::random_device()()
+    );
+    #endif
+    return thread_engine;
+}
+inline void
+cluster::random::seed(const uint64_t seed_value)
+{
+    engine().seed(seed_value);
+}
+inline std::vector<cluster::random::Engine>
+cluster::random::streams(const size_t count)
+{
+    Engine& source = engine();
+    std::vector<Engine> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        source.jump();
+        result.push_back(source);
+    }
+    source.jump();
+    return result;
+}
+
+template<typename IntegralType>
+IntegralType
+cluster::random::int_in_range(Engine& generator, 
+                              const IntegralType min, const IntegralType max)
+{
+    static_assert(std::is_integral<IntegralType>::value, 
+                  "integral type required");
+
+    std::uniform_int_distribution<IntegralType> distribution(min, max);
+    return distribution(generator);
+}
+template<typename IntegralType>
+IntegralType
+cluster::random::int_in_range(const IntegralType min, const IntegralType max)
+{
+    return int_in_range(engine(), min, max);
+}
+template<typename RealType>
+RealType
+cluster::random::real_in_range(Engine& generator, 
+                               const RealType min, const RealType max)
+{
+    static_assert(std::is_floating_point<RealType>::value, 
+                  "floating-point type required");
+
+    std::uniform_real_distribution<RealType> distribution(min, max);
+    return distribution(generator);
+}
+template<typename RealType>
+RealType
+cluster::random::real_in_range(const RealType min, const RealType max)
+{
+    return real_in_range(engine(), min, max);
+}
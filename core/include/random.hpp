@@ -1,15 +1,16 @@
 #ifndef K_MEANS_RANDOM_H
 #define K_MEANS_RANDOM_H
 /**
- * @file seeder.hpp
+ * @file random.hpp
  * @author Raoul Harel
  * @url github.com/rharel/cpp-k-means-clustering
  *
- * Seeder methods.
+ * Random helpers.
  */
 
 
-#include <random>
+#include <cstdint>
+#include <vector>
 
 
 namespace cluster
@@ -20,26 +21,106 @@ namespace cluster
     namespace random
     {
         /**
-         * Gets random integral type in range.
+         * The xoshiro256** generator of Blackman and Vigna.
+         *
+         * @details
+         *  Satisfies UniformRandomBitGenerator, so it works with the standard 
+         *  distributions. Its period is 2^256 - 1, and jump() advances it by 
+         *  2^128 steps in constant time, which splits one seed into 
+         *  non-overlapping streams for parallel use.
          */
-        template<typename IntegralType>
-        IntegralType int_in_range(IntegralType min, IntegralType max)
+        class Engine
         {
-            static_assert(std::is_integral<IntegralType>::value, 
-                          "integral type required");
-
-            #ifdef _DEBUG
-            static std::mt19937 engine;  // use default seed
-            #else
-            static std::random_device device;
-            static std::mt19937 engine(device());
-            #endif
+            public:
+            typedef uint64_t result_type;
+
+            /**
+             * Gets smallest value generated.
+             */
+            static constexpr result_type min() { return 0; }
+            /**
+             * Gets largest value generated.
+             */
+            static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+            /**
+             * Creates a new engine from a seed.
+             */
+            explicit Engine(uint64_t seed_value = 0);
+
+            /**
+             * Resets the state from a seed.
+             */
+            void seed(uint64_t seed_value);
+
+            /**
+             * Generates the next value.
+             */
+            result_type operator()();
             
-            std::uniform_int_distribution<IntegralType> distribution(min, max);
-            return distribution(engine);
-        }
+            /**
+             * Advances by 2^128 steps.
+             */
+            void jump();
+
+            private:
+            uint64_t state_[4];
+        };
+
+        /**
+         * Gets the calling thread's engine.
+         *
+         * @details
+         *  Each thread's engine starts from the default seed in debug builds, 
+         *  and from std::random_device otherwise.
+         */
+        Engine& engine();
+        /**
+         * Seeds the calling thread's engine.
+         *
+         * @details
+         *  Seeding makes all randomness drawn on the calling thread 
+         *  reproducible, including the streams() it hands to worker threads.
+         */
+        void seed(uint64_t seed_value);
+        /**
+         * Splits independent streams off the calling thread's engine.
+         *
+         * @details
+         *  Stream i is the engine jumped i + 1 times. The engine itself then 
+         *  jumps past all of them, so no two streams, nor later draws, overlap.
+         *
+         * @param count Number of streams, typically one per worker.
+         */
+        std::vector<Engine> streams(size_t count);
+
+        /**
+         * Gets random integral type in range [min, max] from an engine.
+         */
+        template<typename IntegralType>
+        IntegralType int_in_range(Engine& generator, IntegralType min, IntegralType max);
+        /**
+         * Gets random integral type in range [min, max] from the calling 
+         * thread's engine.
+         */
+        template<typename IntegralType>
+        IntegralType int_in_range(IntegralType min, IntegralType max);
+        /**
+         * Gets random floating-point type in range [min, max) from an engine.
+         */
+        template<typename RealType>
+        RealType real_in_range(Engine& generator, RealType min, RealType max);
+        /**
+         * Gets random floating-point type in range [min, max) from the 
+         * calling thread's engine.
+         */
+        template<typename RealType>
+        RealType real_in_range(RealType min, RealType max);
     }
 }
 
 
+#include "random.cpp"
+
+
 #endif  // K_MEANS_RANDOM_H
@@ -10,36 +10,649 @@
 #include "seeder.hpp"
 #include "random.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
+
+
+namespace cluster
+{
+    namespace seeder
+    {
+        namespace detail
+        {
+            /**
+             * Number of observations per block of a seeding pass.
+             *
+             * @details
+             *  Workers process whole blocks, and each block keeps its own 
+             *  totals and random stream, so that seeding draws the same 
+             *  means on any number of workers.
+             */
+            const size_t BLOCK_LENGTH = 16384;
+            /**
+             * Number of sampling rounds of k-means||.
+             */
+            const size_t PARALLEL_ROUND_COUNT = 5;
+            /**
+             * Expected number of candidates k-means|| samples per round, 
+             * per mean.
+             */
+            const double PARALLEL_OVERSAMPLING = 2.0;
+            /**
+             * Length of the Markov chain AFK-MC^2 runs per mean.
+             */
+            const size_t CHAIN_LENGTH = 200;
+
+            /**
+             * Gets number of blocks of n observations.
+             */
+            inline size_t block_count(const size_t n)
+            {
+                return (n + BLOCK_LENGTH - 1) / BLOCK_LENGTH;
+            }
+            /**
+             * Gets number of workers for a pass over n observations.
+             */
+            inline size_t block_worker_count(const size_t n, const size_t thread_count)
+            {
+                return parallel::worker_count(block_count(n), thread_count);
+            }
+            /**
+             * Splits [0, n) into blocks, and processes consecutive blocks on 
+             * each worker.
+             *
+             * @details Function is called as function(block, begin, end).
+             */
+            template<typename Function>
+            void for_each_block(const size_t n, const size_t workers, Function function)
+            {
+                parallel::for_each_range
+                (
+                    block_count(n), workers,
+                    [n, &function](size_t, const size_t first_block, const size_t last_block)
+                    {
+                        for (size_t block = first_block; block < last_block; ++block)
+                        {
+                            function(block, block * BLOCK_LENGTH, 
+                                     std::min(n, (block + 1) * BLOCK_LENGTH));
+                        }
+                    }
+                );
+            }
+
+            /**
+             * Selects an observation with probability proportional to its 
+             * weighted score.
+             *
+             * @param scores  Per-observation scores.
+             * @param weights Pointer to first weight, or nullptr for unit 
+             *                weights.
+             * @param totals  Sum of weighted scores in each block.
+             */
+            inline size_t sample(const std::vector<float>& scores, const float* weights,
+                                 const std::vector<double>& totals)
+            {
+                const size_t n = scores.size(),
+                             blocks = totals.size();
+                double total = 0;
+                for (const double block_total : totals) { total += block_total; }
+                if (!(total > 0)) { return random::int_in_range<size_t>(0, n - 1); }
+
+                double remaining = random::real_in_range<double>(0, total);
+                size_t block = 0;
+                while (block + 1 < blocks && remaining >= totals[block])
+                {
+                    remaining -= totals[block];
+                    ++ block;
+                }
+                // rounding may leave the sample past the block's last score
+                const size_t begin = block * BLOCK_LENGTH,
+                             end = std::min(n, begin + BLOCK_LENGTH);
+                size_t last_positive = n;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const float score = weights == nullptr ? scores[i] : weights[i] * scores[i];
+                    if (score > 0) { last_positive = i; }
+                    if (remaining < score) { return i; }
+                    remaining -= score;
+                }
+                return last_positive < n ? 
+                       last_positive : 
+                       random::int_in_range<size_t>(0, n - 1);
+            }
+
+            /**
+             * Sums weights in each block.
+             *
+             * @param weights Pointer to first weight, or nullptr for unit 
+             *                weights.
+             */
+            inline std::vector<double> weight_totals(const size_t n, const float* weights)
+            {
+                std::vector<double> totals(block_count(n), 0);
+                for (size_t block = 0; block < totals.size(); ++block)
+                {
+                    const size_t range_begin = block * BLOCK_LENGTH,
+                                 range_end = std::min(n, range_begin + BLOCK_LENGTH);
+                    totals[block] = static_cast<double>(range_end - range_begin);
+                    if (weights != nullptr)
+                    {
+                        totals[block] = 0;
+                        for (size_t i = range_begin; i < range_end; ++i) 
+                        { 
+                            totals[block] += weights[i]; 
+                        }
+                    }
+                }
+                return totals;
+            }
+
+            /**
+             * k-means++ over observations at [begin, begin + n).
+             *
+             * @details
+             *  Keeps each observation's nearest mean so far. A new mean that 
+             *  is at least twice as far from that mean as the observation 
+             *  cannot be nearer to it (triangle inequality), so the 
+             *  observation is skipped without being read.
+             *
+             * @param weights      Pointer to first weight, or nullptr for unit 
+             *                     weights.
+             * @param thread_count Number of threads, zero for the hardware's.
+             */
+            template<typename T, size_t D, typename RandomIt, typename OutIt>
+            void k_means_plus_plus(size_t k, RandomIt begin, size_t n,
+                                   const float* weights, OutIt out, 
+                                   const size_t thread_count)
+            {
+                if (n == 0)
+                {
+                    std::fill_n(out, k, Vector<T, D>());
+                    return;
+                }
+                const size_t workers = block_worker_count(n, thread_count);
+                // squared distance to the nearest mean so far
+                std::vector<float> distances(n, 1.0f);
+                std::vector<unsigned int> nearest_means(n, 0);
+                std::vector<double> totals = weight_totals(n, weights);
+
+                std::vector<Vector<T, D>> result(k);
+                std::vector<float> mean_distances(k);
+                for (size_t c = 0; c < k; ++c)
+                {
+                    result[c] = begin[sample(distances, weights, totals)];
+                    if (c + 1 == k) { break; }
+
+                    const Vector<T, D>& mean = result[c];
+                    for (size_t j = 0; j < c; ++j)
+                    {
+                        mean_distances[j] = distance::euclidean2<T, D>(result[j], mean);
+                    }
+                    for_each_block
+                    (
+                        n, workers,
+                        [&](const size_t block, const size_t range_begin, const size_t range_end)
+                        {
+                            double total = 0;
+                            for (size_t i = range_begin; i < range_end; ++i)
+                            {
+                                float& distance = distances[i];
+                                if (c == 0 || mean_distances[nearest_means[i]] < 4 * distance)
+                                {
+                                    const float distance_to_mean = 
+                                        distance::euclidean2<T, D>(begin[i], mean);
+                                    if (c == 0 || distance_to_mean < distance)
+                                    {
+                                        distance = distance_to_mean;
+                                        nearest_means[i] = static_cast<unsigned int>(c);
+                                    }
+                                }
+                                total += weights == nullptr ? distance : weights[i] * distance;
+                            }
+                            totals[block] = total;
+                        }
+                    );
+                }
+                std::copy_n(result.begin(), k, out);
+            }
+
+            /**
+             * k-means|| over observations at [begin, begin + n).
+             *
+             * @param weights      Pointer to first weight, or nullptr for unit 
+             *                     weights.
+             * @param thread_count Number of threads, zero for the hardware's.
+             */
+            template<typename T, size_t D, typename RandomIt, typename OutIt>
+            void k_means_parallel(size_t k, RandomIt begin, size_t n,
+                                  const float* weights, OutIt out, 
+                                  const size_t thread_count)
+            {
+                if (n == 0)
+                {
+                    std::fill_n(out, k, Vector<T, D>());
+                    return;
+                }
+                const size_t workers = block_worker_count(n, thread_count);
+                const double oversampling = PARALLEL_OVERSAMPLING * k;
+                // squared distance to the nearest candidate so far
+                std::vector<float> distances(n, 1.0f);
+                std::vector<unsigned int> nearest_candidates(n, 0);
+                std::vector<double> totals = weight_totals(n, weights);
+
+                std::vector<Vector<T, D>> candidates;
+                candidates.push_back(begin[sample(distances, weights, totals)]);
+                size_t new_candidates_begin = 0;
+                // new candidates by distance from each old one
+                std::vector<std::pair<float, unsigned int>> neighbours;
+                for (size_t round = 0; ; ++round)
+                {
+                    // an observation skips every new candidate at least twice
+                    // as far as itself from its nearest old candidate; sorting
+                    // lets it stop at the first such one. Done when the sort
+                    // costs no more than a pass over the observations. A 
+                    // round that sampled nothing leaves the distances as 
+                    // they are.
+                    const size_t old_count = new_candidates_begin,
+                                 new_count = candidates.size() - new_candidates_begin;
+                    const bool is_pruning = round > 0 && new_count > 0 && 
+                                            old_count * new_count <= n;
+                    if (is_pruning)
+                    {
+                        neighbours.resize(old_count * new_count);
+                        parallel::for_each_range
+                        (
+                            old_count, 
+                            parallel::worker_count(old_count * new_count / BLOCK_LENGTH, 
+                                                   thread_count),
+                            [&](size_t, const size_t range_begin, const size_t range_end)
+                            {
+                                for (size_t a = range_begin; a < range_end; ++a)
+                                {
+                                    std::pair<float, unsigned int>* row = &neighbours[a * new_count];
+                                    for (size_t b = 0; b < new_count; ++b)
+                                    {
+                                        const size_t c = new_candidates_begin + b;
+                                        row[b].first = distance::euclidean2<T, D>(candidates[a], 
+                                                                                  candidates[c]);
+                                        row[b].second = static_cast<unsigned int>(c);
+                                    }
+                                    std::sort(row, row + new_count);
+                                }
+                            }
+                        );
+                    }
+                    for_each_block
+                    (
+                        n, workers,
+                        [&](const size_t block, const size_t range_begin, const size_t range_end)
+                        {
+                            double total = 0;
+                            for (size_t i = range_begin; i < range_end; ++i)
+                            {
+                                float& distance = distances[i];
+                                const auto update = [&](const size_t c)
+                                {
+                                    const float distance_to_candidate = 
+                                        distance::euclidean2<T, D>(begin[i], candidates[c]);
+                                    if (round == 0 || distance_to_candidate < distance)
+                                    {
+                                        distance = distance_to_candidate;
+                                        nearest_candidates[i] = static_cast<unsigned int>(c);
+                                    }
+                                };
+                                if (is_pruning)
+                                {
+                                    const std::pair<float, unsigned int>* row = 
+                                        &neighbours[nearest_candidates[i] * new_count];
+                                    const float bound = 4 * distance;
+                                    for (size_t b = 0; b < new_count && row[b].first < bound; ++b)
+                                    {
+                                        update(row[b].second);
+                                    }
+                                }
+                                else
+                                {
+                                    for (size_t c = new_candidates_begin; c < candidates.size(); ++c)
+                                    {
+                                        update(c);
+                                    }
+                                }
+                                total += weights == nullptr ? distance : weights[i] * distance;
+                            }
+                            totals[block] = total;
+                        }
+                    );
+                    double cost = 0;
+                    for (const double block_total : totals) { cost += block_total; }
+                    if (round == PARALLEL_ROUND_COUNT || !(cost > 0)) { break; }
+
+                    // observations are sampled independently, each block 
+                    // with its own stream
+                    std::vector<random::Engine> engines = random::streams(totals.size());
+                    std::vector<std::vector<size_t>> sampled(totals.size());
+                    for_each_block
+                    (
+                        n, workers,
+                        [&](const size_t block, const size_t range_begin, const size_t range_end)
+                        {
+                            random::Engine& engine = engines[block];
+                            for (size_t i = range_begin; i < range_end; ++i)
+                            {
+                                const double score = weights == nullptr ? 
+                                                     distances[i] : 
+                                                     weights[i] * distances[i];
+                                if (random::real_in_range<double>(engine, 0, cost) < 
+                                    oversampling * score)
+                                {
+                                    sampled[block].push_back(i);
+                                }
+                            }
+                        }
+                    );
+                    new_candidates_begin = candidates.size();
+                    for (const std::vector<size_t>& indices : sampled)
+                    {
+                        for (const size_t i : indices) { candidates.push_back(begin[i]); }
+                    }
+                }
+
+                // each candidate weighs as much as the observations nearest 
+                // to it. Summed in order, so that rounding does not depend on 
+                // the workers; a pass of additions costs little next to the 
+                // distance passes above.
+                const size_t candidate_count = candidates.size();
+                std::vector<double> weight_sums(candidate_count, 0);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    weight_sums[nearest_candidates[i]] += weights == nullptr ? 1.0f : weights[i];
+                }
+                std::vector<float> candidate_weights(weight_sums.begin(), weight_sums.end());
+                k_means_plus_plus<T, D>(k, candidates.begin(), candidate_count, 
+                                        &candidate_weights[0], out, thread_count);
+            }
+
+            /**
+             * Fills a reservoir that saw fewer than k observations by 
+             * repeating them in order, or with zero vectors if it saw none.
+             */
+            template<typename T, size_t D>
+            void repeat_to_size(std::vector<Vector<T, D>>& reservoir, const size_t k)
+            {
+                const size_t count = reservoir.size();
+                if (count == 0) 
+                { 
+                    reservoir.resize(k);
+                    return;
+                }
+                for (size_t i = count; i < k; ++i)
+                {
+                    reservoir.push_back(reservoir[i % count]);
+                }
+            }
+
+            /**
+             * Walker's alias table, for sampling a discrete distribution in 
+             * constant time.
+             */
+            class AliasTable
+            {
+                public:
+                /**
+                 * Builds the table in O(n), by Vose's method.
+                 *
+                 * @param masses Non-negative masses, not all zero, so not 
+                 *               empty either.
+                 */
+                explicit AliasTable(const std::vector<double>& masses) :
+                    thresholds_(masses.size(), 1.0),
+                    aliases_(masses.size())
+                {
+                    const size_t n = masses.size();
+                    double total = 0;
+                    for (const double mass : masses) { total += mass; }
+
+                    std::vector<double> scaled(n);
+                    std::vector<size_t> small, large;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        aliases_[i] = static_cast<unsigned int>(i);
+                        scaled[i] = masses[i] * static_cast<double>(n) / total;
+                        (scaled[i] < 1 ? small : large).push_back(i);
+                    }
+                    while (!small.empty() && !large.empty())
+                    {
+                        const size_t less = small.back(),
+                                     more = large.back();
+                        small.pop_back();
+                        thresholds_[less] = scaled[less];
+                        aliases_[less] = static_cast<unsigned int>(more);
+                        scaled[more] -= 1 - scaled[less];
+                        if (scaled[more] < 1)
+                        {
+                            large.pop_back();
+                            small.push_back(more);
+                        }
+                    }
+                    // entries left over by rounding keep threshold one
+                }
+
+                /**
+                 * Gets a random index, with probability proportional to its 
+                 * mass.
+                 */
+                size_t sample() const
+                {
+                    const size_t i = random::int_in_range<size_t>(0, thresholds_.size() - 1);
+                    return random::real_in_range<double>(0, 1) < thresholds_[i] ? 
+                           i : aliases_[i];
+                }
+
+                private:
+                std::vector<double> thresholds_;
+                std::vector<unsigned int> aliases_;
+            };
+
+            /**
+             * AFK-MC^2 over observations at [begin, begin + n).
+             *
+             * @param weights      Pointer to first weight, or nullptr for unit 
+             *                     weights.
+             * @param thread_count Number of threads, zero for the hardware's.
+             */
+            template<typename T, size_t D, typename RandomIt, typename OutIt>
+            void afk_mc2(size_t k, RandomIt begin, size_t n,
+                         const float* weights, OutIt out, 
+                         const size_t thread_count)
+            {
+                if (k == 0) { return; }
+                if (n == 0)
+                {
+                    std::fill_n(out, k, Vector<T, D>());
+                    return;
+                }
+                const size_t workers = block_worker_count(n, thread_count);
+                std::vector<Vector<T, D>> result(k);
+                {
+                    const std::vector<double> masses = weights == nullptr ? 
+                        std::vector<double>(n, 1.0) : 
+                        std::vector<double>(weights, weights + n);
+                    result[0] = begin[AliasTable(masses).sample()];
+                }
+                if (k == 1) 
+                { 
+                    std::copy_n(result.begin(), k, out);
+                    return;
+                }
+
+                // the proposal mixes D^2 sampling from the first mean with 
+                // uniform sampling, in equal parts
+                std::vector<double> proposal(n);
+                const size_t blocks = block_count(n);
+                std::vector<double> totals(blocks, 0), weight_totals(blocks, 0);
+                for_each_block
+                (
+                    n, workers,
+                    [&](const size_t block, const size_t range_begin, const size_t range_end)
+                    {
+                        for (size_t i = range_begin; i < range_end; ++i)
+                        {
+                            const double weight = weights == nullptr ? 1.0 : weights[i];
+                            proposal[i] = weight * distance::euclidean2<T, D>(begin[i], result[0]);
+                            totals[block] += proposal[i];
+                            weight_totals[block] += weight;
+                        }
+                    }
+                );
+                double total = 0, weight_total = 0;
+                for (size_t block = 0; block < blocks; ++block)
+                {
+                    total += totals[block];
+                    weight_total += weight_totals[block];
+                }
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double weight = weights == nullptr ? 1.0 : weights[i];
+                    proposal[i] = (total > 0 ? proposal[i] / total / 2 : 0) + 
+                                  weight / weight_total / (total > 0 ? 2 : 1);
+                }
+                const AliasTable table(proposal);
+
+                // weight times squared distance to the nearest mean so far
+                const auto score = [&](const size_t index, const size_t mean_count)
+                {
+                    float distance = distance::euclidean2<T, D>(begin[index], result[0]);
+                    for (size_t j = 1; j < mean_count; ++j)
+                    {
+                        distance = std::min(distance, 
+                                            distance::euclidean2<T, D>(begin[index], result[j]));
+                    }
+                    return (weights == nullptr ? 1.0 : weights[index]) * distance;
+                };
+                for (size_t c = 1; c < k; ++c)
+                {
+                    // Metropolis-Hastings chain whose stationary distribution 
+                    // is weighted D^2 sampling from the means so far
+                    size_t x = table.sample();
+                    double x_score = score(x, c);
+                    for (size_t step = 1; step < CHAIN_LENGTH; ++step)
+                    {
+                        const size_t y = table.sample();
+                        const double y_score = score(y, c);
+                        if (y_score * proposal[x] > 
+                            x_score * proposal[y] * random::real_in_range<double>(0, 1))
+                        {
+                            x = y;
+                            x_score = y_score;
+                        }
+                    }
+                    result[c] = begin[x];
+                }
+                std::copy_n(result.begin(), k, out);
+            }
+        }
+    }
+}
+
 
 template<typename T, size_t D, typename InIt, typename OutIt>
 void
 cluster::seeder::forgy(size_t k, InIt begin, InIt end, OutIt out)
 {
-    std::vector<Vector<T, D>> result(k);
-    std::vector<Vector<T, D>> observations(begin, end);
-    const size_t n = observations.size();
-    for (size_t i = 0; i < k; ++i)
+    if (k == 0) { return; }
+    // reservoir sampling by Li's algorithm L, which draws a number of 
+    // observations to skip instead of a random number per observation
+    std::vector<Vector<T, D>> result;
+    result.reserve(k);
+    for (; begin != end && result.size() < k; ++begin)
+    {
+        result.push_back(*begin);
+    }
+    const double exponent = 1.0 / static_cast<double>(k);
+    double threshold = std::exp(std::log(1 - random::real_in_range<double>(0, 1)) * exponent);
+    while (begin != end)
+    {
+        const double skip = std::floor
+        (
+            std::log(1 - random::real_in_range<double>(0, 1)) / 
+            std::log(1 - threshold)
+        );
+        for (double i = 0; i < skip && begin != end; ++i) { ++begin; }
+        if (begin == end) { break; }
+
+        result[random::int_in_range<size_t>(0, k - 1)] = *begin;
+        ++begin;
+        threshold *= std::exp(std::log(1 - random::real_in_range<double>(0, 1)) * exponent);
+    }
+    detail::repeat_to_size(result, k);
+    std::copy_n(result.begin(), k, out);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+void
+cluster::seeder::forgy(size_t k, InIt begin, InIt end, WIt weights, OutIt out)
+{
+    if (k == 0) { return; }
+    // weighted reservoir sampling by Efraimidis and Spirakis' algorithm 
+    // A-ExpJ. Observation i holds key u_i^(1 / w_i), kept here as its 
+    // logarithm, and the reservoir holds the k largest keys. Exponential 
+    // jumps draw how much weight to skip before the next replacement.
+    typedef std::pair<double, size_t> Key;
+    std::vector<Vector<T, D>> result;
+    result.reserve(k);
+    std::priority_queue<Key, std::vector<Key>, std::greater<Key>> keys;
+    for (; begin != end && result.size() < k; ++begin, ++weights)
     {
-        result.at(i) = observations[random::int_in_range<size_t>(0, n - 1)];
+        const double weight = static_cast<double>(*weights);
+        if (weight <= 0) { continue; }
+        keys.push(Key(std::log(1 - random::real_in_range<double>(0, 1)) / weight, 
+                      result.size()));
+        result.push_back(*begin);
     }
+    double jump = keys.empty() ? 0 :
+                  std::log(1 - random::real_in_range<double>(0, 1)) / keys.top().first;
+    for (; begin != end; ++begin, ++weights)
+    {
+        const double weight = static_cast<double>(*weights);
+        jump -= weight;
+        if (weight <= 0 || jump > 0) { continue; }
+
+        // the new key is conditioned to beat the smallest one
+        const double least_key = keys.top().first;
+        const size_t slot = keys.top().second;
+        const double bound = std::exp(least_key * weight);
+        const double key = std::log
+        (
+            bound + (1 - bound) * (1 - random::real_in_range<double>(0, 1))
+        ) / weight;
+        keys.pop();
+        keys.push(Key(key, slot));
+        result[slot] = *begin;
+        jump = std::log(1 - random::real_in_range<double>(0, 1)) / keys.top().first;
+    }
+    detail::repeat_to_size(result, k);
     std::copy_n(result.begin(), k, out);
 }
 template<typename T, size_t D, typename InIt, typename OutIt>
 void
 cluster::seeder::random_partition(size_t k, InIt begin, InIt end, OutIt out)
 {
+    if (k == 0) { return; }
     std::vector<Vector<T, D>> result(k);
     std::vector<size_t> assigned_observation_counts(k);
-    std::vector<Vector<T, D>> observations(begin, end);
-    const size_t n = observations.size();
-    for (size_t i = 0; i < n; ++i)
+    for (; begin != end; ++begin)
     {
         const size_t cls = random::int_in_range<size_t>(0, k - 1);
-        result.at(cls) += observations.at(i);
+        result.at(cls) += *begin;
         ++ assigned_observation_counts.at(cls);
     }
     for (size_t i = 0; i < k; ++i)
     {
+        if (assigned_observation_counts.at(i) == 0) { continue; }
         result.at(i) = result.at(i).scale
         (
             1.0f / 
@@ -48,3 +661,127 @@ cluster::seeder::random_partition(size_t k, InIt begin, InIt end, OutIt out)
     }
     std::copy_n(result.begin(), k, out);
 }
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+void
+cluster::seeder::random_partition(size_t k, InIt begin, InIt end, WIt weights, OutIt out)
+{
+    if (k == 0) { return; }
+    std::vector<Vector<T, D>> result(k);
+    std::vector<double> assigned_weights(k);
+    for (; begin != end; ++begin, ++weights)
+    {
+        const size_t cls = random::int_in_range<size_t>(0, k - 1);
+        Vector<T, D> observation = *begin;
+        result.at(cls) += observation.scale(static_cast<float>(*weights));
+        assigned_weights.at(cls) += *weights;
+    }
+    for (size_t i = 0; i < k; ++i)
+    {
+        if (!(assigned_weights.at(i) > 0)) { continue; }
+        result.at(i) = result.at(i).scale
+        (
+            1.0f / 
+            static_cast<float>(assigned_weights.at(i))
+        );
+    }
+    std::copy_n(result.begin(), k, out);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::k_means_plus_plus(size_t k, InIt begin, InIt end, OutIt out)
+{
+    k_means_plus_plus<T, D>(k, begin, end, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+typename std::enable_if<!std::is_integral<OutIt>::value>::type
+cluster::seeder::k_means_plus_plus(size_t k, InIt begin, InIt end, WIt weights, OutIt out)
+{
+    k_means_plus_plus<T, D>(k, begin, end, weights, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::k_means_plus_plus(size_t k, InIt begin, InIt end, OutIt out, 
+                                   const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    detail::k_means_plus_plus<T, D>(k, begin, n, nullptr, out, thread_count);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+void
+cluster::seeder::k_means_plus_plus(size_t k, InIt begin, InIt end, WIt weights, OutIt out, 
+                                   const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    std::vector<float> observation_weights(n);
+    for (size_t i = 0; i < n; ++i, ++weights)
+    {
+        observation_weights[i] = static_cast<float>(*weights);
+    }
+    detail::k_means_plus_plus<T, D>(k, begin, n, observation_weights.data(), out, thread_count);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::k_means_parallel(size_t k, InIt begin, InIt end, OutIt out)
+{
+    k_means_parallel<T, D>(k, begin, end, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+typename std::enable_if<!std::is_integral<OutIt>::value>::type
+cluster::seeder::k_means_parallel(size_t k, InIt begin, InIt end, WIt weights, OutIt out)
+{
+    k_means_parallel<T, D>(k, begin, end, weights, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::k_means_parallel(size_t k, InIt begin, InIt end, OutIt out, 
+                                  const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    detail::k_means_parallel<T, D>(k, begin, n, nullptr, out, thread_count);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+void
+cluster::seeder::k_means_parallel(size_t k, InIt begin, InIt end, WIt weights, OutIt out, 
+                                  const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    std::vector<float> observation_weights(n);
+    for (size_t i = 0; i < n; ++i, ++weights)
+    {
+        observation_weights[i] = static_cast<float>(*weights);
+    }
+    detail::k_means_parallel<T, D>(k, begin, n, observation_weights.data(), out, thread_count);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::afk_mc2(size_t k, InIt begin, InIt end, OutIt out)
+{
+    afk_mc2<T, D>(k, begin, end, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+typename std::enable_if<!std::is_integral<OutIt>::value>::type
+cluster::seeder::afk_mc2(size_t k, InIt begin, InIt end, WIt weights, OutIt out)
+{
+    afk_mc2<T, D>(k, begin, end, weights, out, 0);
+}
+template<typename T, size_t D, typename InIt, typename OutIt>
+void
+cluster::seeder::afk_mc2(size_t k, InIt begin, InIt end, OutIt out, 
+                         const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    detail::afk_mc2<T, D>(k, begin, n, nullptr, out, thread_count);
+}
+template<typename T, size_t D, typename InIt, typename WIt, typename OutIt>
+void
+cluster::seeder::afk_mc2(size_t k, InIt begin, InIt end, WIt weights, OutIt out, 
+                         const size_t thread_count)
+{
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+    std::vector<float> observation_weights(n);
+    for (size_t i = 0; i < n; ++i, ++weights)
+    {
+        observation_weights[i] = static_cast<float>(*weights);
+    }
+    detail::afk_mc2<T, D>(k, begin, n, observation_weights.data(), out, thread_count);
+}
@@ -9,8 +9,12 @@
  */
 
 
+#include "distance.hpp"
+#include "parallel.hpp"
 #include "Vector.hpp"
 
+#include <type_traits>
+
 
 namespace cluster
 {
@@ -36,7 +40,11 @@ namespace cluster
         /**
          * The forgy method.
          *
-         * @details Selects random observations to be initial means.
+         * @details 
+         *  Selects k distinct random observations to be initial means, by 
+         *  reservoir sampling in a single pass with no copy of the input. 
+         *  Repeats observations if there are fewer than k, and outputs zero
+         *  vectors if there are none.
          *
          * @see SeederFunction
          */
@@ -45,10 +53,38 @@ namespace cluster
         void forgy(size_t k, 
               InputIterator begin, InputIterator end,
               OutputIterator out);
+        /**
+         * The weighted forgy method.
+         *
+         * @details 
+         *  Selects k distinct random observations to be initial means, by 
+         *  weighted reservoir sampling in a single pass with no copy of the 
+         *  input. Each draw picks an observation with probability 
+         *  proportional to its weight among those not yet picked. Repeats 
+         *  observations if fewer than k have positive weight, and outputs 
+         *  zero vectors if none has.
+         *
+         * @tparam WeightIterator Iterator type of the weight container.
+         *
+         * @param weights Iterator to weight of first observation. Weights are 
+         *                non-negative, and not all zero.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        void forgy(size_t k, 
+              InputIterator begin, InputIterator end,
+              WeightIterator weights,
+              OutputIterator out);
         /**
          * The random partition method.
          *
-         * @details Assigns random clusters to observations and computes the means.
+         * @details 
+         *  Assigns random clusters to observations and computes the means, 
+         *  in a single pass with no copy of the input. Clusters that receive
+         *  no observation get a zero mean.
          *
          * @see SeederFunction
          */
@@ -57,6 +93,261 @@ namespace cluster
         void random_partition(size_t k, 
                          InputIterator begin, InputIterator end,
                          OutputIterator out);
+        /**
+         * The weighted random partition method.
+         *
+         * @details 
+         *  Assigns random clusters to observations and computes the weighted 
+         *  means, in a single pass with no copy of the input. Clusters that 
+         *  receive no weight get a zero mean.
+         *
+         * @tparam WeightIterator Iterator type of the weight container.
+         *
+         * @param weights Iterator to weight of first observation.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        void random_partition(size_t k, 
+                         InputIterator begin, InputIterator end,
+                         WeightIterator weights,
+                         OutputIterator out);
+        /**
+         * The k-means++ method of Arthur and Vassilvitskii.
+         *
+         * @details
+         *  Selects the first mean uniformly at random, and each subsequent 
+         *  mean with probability proportional to its squared Euclidean 
+         *  distance from the nearest mean selected so far (D^2 sampling).
+         *
+         *  After each selection, one parallel pass over the observations 
+         *  updates their distances and the distance totals of fixed-length 
+         *  blocks. A sample then picks a block by the prefix sums of the 
+         *  totals, and scans only that block. Seeding takes k passes. 
+         *  Outputs zero vectors if there are no observations.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void k_means_plus_plus(size_t k, 
+                               InputIterator begin, InputIterator end,
+                               OutputIterator out);
+        /**
+         * The weighted k-means++ method.
+         *
+         * @details
+         *  As k_means_plus_plus(), with each observation's probability also 
+         *  proportional to its weight.
+         *
+         * @tparam WeightIterator Iterator type of the weight container.
+         *
+         * @param weights Iterator to weight of first observation. Weights are 
+         *                non-negative, and not all zero.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @note 
+         *  Not viable for an integral OutputIterator, so that a call with a 
+         *  thread count resolves to the overload that takes one. The same 
+         *  holds for the weighted k_means_parallel() and afk_mc2().
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        typename std::enable_if<!std::is_integral<OutputIterator>::value>::type 
+        k_means_plus_plus(size_t k, 
+                          InputIterator begin, InputIterator end,
+                          WeightIterator weights,
+                          OutputIterator out);
+        /**
+         * The k-means++ method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see k_means_plus_plus
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void k_means_plus_plus(size_t k, 
+                               InputIterator begin, InputIterator end,
+                               OutputIterator out,
+                               size_t thread_count);
+        /**
+         * The weighted k-means++ method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see k_means_plus_plus
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        void k_means_plus_plus(size_t k, 
+                               InputIterator begin, InputIterator end,
+                               WeightIterator weights,
+                               OutputIterator out,
+                               size_t thread_count);
+        /**
+         * The k-means|| method of Bahmani et al.
+         *
+         * @details
+         *  Starts from one random candidate, then for a few rounds samples 
+         *  each observation independently, with probability 2k times its 
+         *  share of the squared Euclidean distances to the nearest 
+         *  candidate. Each candidate is then weighted by the observations 
+         *  nearest to it, and the weighted candidates are reduced to k means 
+         *  by k_means_plus_plus().
+         *
+         *  Takes a constant number of parallel passes, rather than the k of 
+         *  k_means_plus_plus(), which suits large k. Outputs zero vectors if 
+         *  there are no observations.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void k_means_parallel(size_t k, 
+                              InputIterator begin, InputIterator end,
+                              OutputIterator out);
+        /**
+         * The weighted k-means|| method.
+         *
+         * @details
+         *  As k_means_parallel(), with each observation's probability and 
+         *  contribution to its candidate's weight proportional to its weight.
+         *
+         * @tparam WeightIterator Iterator type of the weight container.
+         *
+         * @param weights Iterator to weight of first observation. Weights are 
+         *                non-negative, and not all zero.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        typename std::enable_if<!std::is_integral<OutputIterator>::value>::type 
+        k_means_parallel(size_t k, 
+                         InputIterator begin, InputIterator end,
+                         WeightIterator weights,
+                         OutputIterator out);
+        /**
+         * The k-means|| method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see k_means_parallel
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void k_means_parallel(size_t k, 
+                              InputIterator begin, InputIterator end,
+                              OutputIterator out,
+                              size_t thread_count);
+        /**
+         * The weighted k-means|| method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see k_means_parallel
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        void k_means_parallel(size_t k, 
+                              InputIterator begin, InputIterator end,
+                              WeightIterator weights,
+                              OutputIterator out,
+                              size_t thread_count);
+        /**
+         * The AFK-MC^2 method of Bachem et al.
+         *
+         * @details
+         *  Approximates k_means_plus_plus() without a pass per mean. One 
+         *  pass over the observations builds a proposal distribution, half 
+         *  D^2 sampling from the first mean and half uniform, in an alias 
+         *  table. Each further mean is then the end of a Markov chain of 200 
+         *  proposals, so seeding costs O(n) once, plus O(k^2) distance 
+         *  computations independent of n.
+         *  Outputs zero vectors if there are no observations.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void afk_mc2(size_t k, 
+                     InputIterator begin, InputIterator end,
+                     OutputIterator out);
+        /**
+         * The weighted AFK-MC^2 method.
+         *
+         * @details
+         *  As afk_mc2(), approximating the weighted k_means_plus_plus().
+         *
+         * @tparam WeightIterator Iterator type of the weight container.
+         *
+         * @param weights Iterator to weight of first observation. Weights are 
+         *                non-negative, and not all zero.
+         *
+         * @pre InputIterator is a random-access iterator.
+         *
+         * @see SeederFunction
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        typename std::enable_if<!std::is_integral<OutputIterator>::value>::type 
+        afk_mc2(size_t k, 
+                InputIterator begin, InputIterator end,
+                WeightIterator weights,
+                OutputIterator out);
+        /**
+         * The AFK-MC^2 method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see afk_mc2
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename OutputIterator>
+        void afk_mc2(size_t k, 
+                     InputIterator begin, InputIterator end,
+                     OutputIterator out,
+                     size_t thread_count);
+        /**
+         * The weighted AFK-MC^2 method on a given number of worker threads.
+         *
+         * @param thread_count Number of threads. Zero selects the hardware's 
+         *                     concurrency, as does the overload without it.
+         *
+         * @see afk_mc2
+         */
+        template<typename NumericType, size_t Dimension, 
+                 typename InputIterator, typename WeightIterator, 
+                 typename OutputIterator>
+        void afk_mc2(size_t k, 
+                     InputIterator begin, InputIterator end,
+                     WeightIterator weights,
+                     OutputIterator out,
+                     size_t thread_count);
     }
 }
 
@@ -0,0 +1,545 @@
+/**
+ * @file simd.cpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Vectorized kernels.
+ */
+
+
+#include "simd.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#ifdef K_MEANS_SIMD_X86
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    #include <immintrin.h>
+#endif
+
+
+// GCC and Clang compile intrinsics only in functions targeting their
+// instruction set; MSVC compiles them anywhere.
+#if defined(__GNUC__)
+    #define K_MEANS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define K_MEANS_SIMD_TARGET(isa)
+#endif
+
+
+namespace cluster
+{
+    namespace simd
+    {
+        namespace detail
+        {
+            typedef float (*Kernel)(const float* a, const float* b, size_t dimension);
+            typedef void (*PanelKernel)(const float* const* rows, const float* panel,
+                                        size_t depth_begin, size_t depth_end,
+                                        float* products, size_t stride);
+
+            struct Kernels
+            {
+                InstructionSet instruction_set;
+                Kernel euclidean2;
+                Kernel manhattan;
+                PanelKernel multiply_panel;
+            };
+
+            inline void multiply_panel_scalar
+            (
+                const float* const* rows, const float* panel,
+                const size_t depth_begin, const size_t depth_end,
+                float* products, const size_t stride
+            )
+            {
+                float accumulators[PANEL_ROW_COUNT][PANEL_WIDTH] = {};
+                for (size_t d = depth_begin; d < depth_end; ++d)
+                {
+                    const float* columns = &panel[d * PANEL_WIDTH];
+                    for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                    {
+                        const float x = rows[r][d];
+                        for (size_t c = 0; c < PANEL_WIDTH; ++c)
+                        {
+                            accumulators[r][c] += x * columns[c];
+                        }
+                    }
+                }
+                for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                {
+                    for (size_t c = 0; c < PANEL_WIDTH; ++c)
+                    {
+                        products[r * stride + c] += accumulators[r][c];
+                    }
+                }
+            }
+
+            #ifdef K_MEANS_SIMD_X86
+            inline void cpuid(const int leaf, const int subleaf, unsigned int registers[4])
+            {
+                #ifdef _MSC_VER
+                int values[4];
+                __cpuidex(values, leaf, subleaf);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    registers[i] = static_cast<unsigned int>(values[i]);
+                }
+                #else
+                __cpuid_count(leaf, subleaf,
+                              registers[0], registers[1], registers[2], registers[3]);
+                #endif
+            }
+            inline unsigned long long xgetbv()
+            {
+                #ifdef _MSC_VER
+                return _xgetbv(0);
+                #else
+                unsigned int eax, edx;
+                __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                return (static_cast<unsigned long long>(edx) << 32) | eax;
+                #endif
+            }
+            inline unsigned int max_cpuid_leaf()
+            {
+                unsigned int registers[4];
+                cpuid(0, 0, registers);
+                return registers[0];
+            }
+
+            K_MEANS_SIMD_TARGET("sse2")
+            inline float horizontal_sum(const __m128 v)
+            {
+                float lanes[4];
+                _mm_storeu_ps(lanes, v);
+                return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
+            K_MEANS_SIMD_TARGET("sse2")
+            inline float euclidean2_sse(const float* a, const float* b, const size_t dimension)
+            {
+                __m128 sum = _mm_setzero_ps();
+                size_t i = 0;
+                for (; i + 4 <= dimension; i += 4)
+                {
+                    const __m128 difference = _mm_sub_ps(_mm_loadu_ps(a + i),
+                                                         _mm_loadu_ps(b + i));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(difference, difference));
+                }
+                float result = horizontal_sum(sum);
+                for (; i < dimension; ++i)
+                {
+                    result += (a[i] - b[i]) * (a[i] - b[i]);
+                }
+                return result;
+            }
+            K_MEANS_SIMD_TARGET("sse2")
+            inline float manhattan_sse(const float* a, const float* b, const size_t dimension)
+            {
+                const __m128 sign = _mm_set1_ps(-0.0f);
+                __m128 sum = _mm_setzero_ps();
+                size_t i = 0;
+                for (; i + 4 <= dimension; i += 4)
+                {
+                    const __m128 difference = _mm_sub_ps(_mm_loadu_ps(a + i),
+                                                         _mm_loadu_ps(b + i));
+                    sum = _mm_add_ps(sum, _mm_andnot_ps(sign, difference));
+                }
+                float result = horizontal_sum(sum);
+                for (; i < dimension; ++i)
+                {
+                    result += std::abs(a[i] - b[i]);
+                }
+                return result;
+            }
+
+            K_MEANS_SIMD_TARGET("sse2")
+            inline void multiply_panel_sse
+            (
+                const float* const* rows, const float* panel,
+                const size_t depth_begin, const size_t depth_end,
+                float* products, const size_t stride
+            )
+            {
+                // 4 x 4 accumulators fill the 16 registers of x64
+                __m128 accumulators[PANEL_ROW_COUNT][4];
+                for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        accumulators[r][c] = _mm_setzero_ps();
+                    }
+                }
+                for (size_t d = depth_begin; d < depth_end; ++d)
+                {
+                    const float* columns = &panel[d * PANEL_WIDTH];
+                    for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                    {
+                        const __m128 x = _mm_set1_ps(rows[r][d]);
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            accumulators[r][c] = _mm_add_ps(accumulators[r][c],
+                                _mm_mul_ps(x, _mm_loadu_ps(columns + 4 * c)));
+                        }
+                    }
+                }
+                for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        float* product = products + r * stride + 4 * c;
+                        _mm_storeu_ps(product, _mm_add_ps(_mm_loadu_ps(product),
+                                                          accumulators[r][c]));
+                    }
+                }
+            }
+
+            K_MEANS_SIMD_TARGET("avx2,fma")
+            inline float horizontal_sum(const __m256 v)
+            {
+                return horizontal_sum(_mm_add_ps(_mm256_castps256_ps128(v),
+                                                 _mm256_extractf128_ps(v, 1)));
+            }
+            K_MEANS_SIMD_TARGET("avx2,fma")
+            inline float euclidean2_avx2(const float* a, const float* b, const size_t dimension)
+            {
+                // two accumulators hide the latency of fused multiply-add
+                __m256 sum0 = _mm256_setzero_ps(),
+                       sum1 = _mm256_setzero_ps();
+                size_t i = 0;
+                for (; i + 16 <= dimension; i += 16)
+                {
+                    const __m256 difference0 = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                                             _mm256_loadu_ps(b + i)),
+                                 difference1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8),
+                                                             _mm256_loadu_ps(b + i + 8));
+                    sum0 = _mm256_fmadd_ps(difference0, difference0, sum0);
+                    sum1 = _mm256_fmadd_ps(difference1, difference1, sum1);
+                }
+                for (; i + 8 <= dimension; i += 8)
+                {
+                    const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                                            _mm256_loadu_ps(b + i));
+                    sum0 = _mm256_fmadd_ps(difference, difference, sum0);
+                }
+                float result = horizontal_sum(_mm256_add_ps(sum0, sum1));
+                for (; i < dimension; ++i)
+                {
+                    result += (a[i] - b[i]) * (a[i] - b[i]);
+                }
+                return result;
+            }
+            K_MEANS_SIMD_TARGET("avx2,fma")
+            inline float manhattan_avx2(const float* a, const float* b, const size_t dimension)
+            {
+                const __m256 sign = _mm256_set1_ps(-0.0f);
+                __m256 sum0 = _mm256_setzero_ps(),
+                       sum1 = _mm256_setzero_ps();
+                size_t i = 0;
+                for (; i + 16 <= dimension; i += 16)
+                {
+                    const __m256 difference0 = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                                             _mm256_loadu_ps(b + i)),
+                                 difference1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8),
+                                                             _mm256_loadu_ps(b + i + 8));
+                    sum0 = _mm256_add_ps(sum0, _mm256_andnot_ps(sign, difference0));
+                    sum1 = _mm256_add_ps(sum1, _mm256_andnot_ps(sign, difference1));
+                }
+                for (; i + 8 <= dimension; i += 8)
+                {
+                    const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                                            _mm256_loadu_ps(b + i));
+                    sum0 = _mm256_add_ps(sum0, _mm256_andnot_ps(sign, difference));
+                }
+                float result = horizontal_sum(_mm256_add_ps(sum0, sum1));
+                for (; i < dimension; ++i)
+                {
+                    result += std::abs(a[i] - b[i]);
+                }
+                return result;
+            }
+
+            K_MEANS_SIMD_TARGET("avx2,fma")
+            inline void multiply_panel_avx2
+            (
+                const float* const* rows, const float* panel,
+                const size_t depth_begin, const size_t depth_end,
+                float* products, const size_t stride
+            )
+            {
+                // accumulators are spelled out so that they stay in registers
+                __m256 row0_columns0 = _mm256_setzero_ps(), row0_columns1 = _mm256_setzero_ps(),
+                       row1_columns0 = _mm256_setzero_ps(), row1_columns1 = _mm256_setzero_ps(),
+                       row2_columns0 = _mm256_setzero_ps(), row2_columns1 = _mm256_setzero_ps(),
+                       row3_columns0 = _mm256_setzero_ps(), row3_columns1 = _mm256_setzero_ps();
+                const float *row0 = rows[0], *row1 = rows[1], *row2 = rows[2], *row3 = rows[3];
+                for (size_t d = depth_begin; d < depth_end; ++d)
+                {
+                    const __m256 columns0 = _mm256_loadu_ps(&panel[d * PANEL_WIDTH]),
+                                 columns1 = _mm256_loadu_ps(&panel[d * PANEL_WIDTH + 8]);
+                    __m256 x = _mm256_set1_ps(row0[d]);
+                    row0_columns0 = _mm256_fmadd_ps(x, columns0, row0_columns0);
+                    row0_columns1 = _mm256_fmadd_ps(x, columns1, row0_columns1);
+                    x = _mm256_set1_ps(row1[d]);
+                    row1_columns0 = _mm256_fmadd_ps(x, columns0, row1_columns0);
+                    row1_columns1 = _mm256_fmadd_ps(x, columns1, row1_columns1);
+                    x = _mm256_set1_ps(row2[d]);
+                    row2_columns0 = _mm256_fmadd_ps(x, columns0, row2_columns0);
+                    row2_columns1 = _mm256_fmadd_ps(x, columns1, row2_columns1);
+                    x = _mm256_set1_ps(row3[d]);
+                    row3_columns0 = _mm256_fmadd_ps(x, columns0, row3_columns0);
+                    row3_columns1 = _mm256_fmadd_ps(x, columns1, row3_columns1);
+                }
+                const __m256 accumulators[PANEL_ROW_COUNT][2] = 
+                {
+                    {row0_columns0, row0_columns1}, {row1_columns0, row1_columns1},
+                    {row2_columns0, row2_columns1}, {row3_columns0, row3_columns1}
+                };
+                for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                {
+                    float* product = products + r * stride;
+                    _mm256_storeu_ps(product, _mm256_add_ps(_mm256_loadu_ps(product),
+                                                            accumulators[r][0]));
+                    _mm256_storeu_ps(product + 8, _mm256_add_ps(_mm256_loadu_ps(product + 8),
+                                                                accumulators[r][1]));
+                }
+            }
+
+            #ifdef K_MEANS_SIMD_AVX512
+            K_MEANS_SIMD_TARGET("avx512f")
+            inline float horizontal_sum(const __m512 v)
+            {
+                // through 256-bit halves: GCC 12 warns on the __Y placeholder inside 
+                // _mm512_reduce_add_ps and _mm512_extractf64x4_pd
+                float lanes[16];
+                _mm512_storeu_ps(lanes, v);
+                const __m256 sum = _mm256_add_ps(_mm256_loadu_ps(lanes), _mm256_loadu_ps(lanes + 8));
+                return horizontal_sum(_mm_add_ps(_mm256_castps256_ps128(sum),
+                                                 _mm256_extractf128_ps(sum, 1)));
+            }
+            K_MEANS_SIMD_TARGET("avx512f")
+            inline float euclidean2_avx512(const float* a, const float* b, const size_t dimension)
+            {
+                __m512 sum0 = _mm512_setzero_ps(),
+                       sum1 = _mm512_setzero_ps();
+                size_t i = 0;
+                for (; i + 32 <= dimension; i += 32)
+                {
+                    const __m512 difference0 = _mm512_sub_ps(_mm512_loadu_ps(a + i),
+                                                             _mm512_loadu_ps(b + i)),
+                                 difference1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16),
+                                                             _mm512_loadu_ps(b + i + 16));
+                    sum0 = _mm512_fmadd_ps(difference0, difference0, sum0);
+                    sum1 = _mm512_fmadd_ps(difference1, difference1, sum1);
+                }
+                // the remainder is loaded under a mask, without a scalar loop
+                for (; i < dimension; i += 16)
+                {
+                    const size_t remaining = dimension - i;
+                    const __mmask16 mask = remaining >= 16 ?
+                                           static_cast<__mmask16>(0xFFFF) :
+                                           static_cast<__mmask16>((1u << remaining) - 1);
+                    const __m512 difference = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                                            _mm512_maskz_loadu_ps(mask, b + i));
+                    sum0 = _mm512_fmadd_ps(difference, difference, sum0);
+                }
+                return horizontal_sum(_mm512_add_ps(sum0, sum1));
+            }
+            K_MEANS_SIMD_TARGET("avx512f")
+            inline float manhattan_avx512(const float* a, const float* b, const size_t dimension)
+            {
+                __m512 sum0 = _mm512_setzero_ps(),
+                       sum1 = _mm512_setzero_ps();
+                size_t i = 0;
+                for (; i + 32 <= dimension; i += 32)
+                {
+                    const __m512 difference0 = _mm512_sub_ps(_mm512_loadu_ps(a + i),
+                                                             _mm512_loadu_ps(b + i)),
+                                 difference1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16),
+                                                             _mm512_loadu_ps(b + i + 16));
+                    sum0 = _mm512_add_ps(sum0, _mm512_abs_ps(difference0));
+                    sum1 = _mm512_add_ps(sum1, _mm512_abs_ps(difference1));
+                }
+                for (; i < dimension; i += 16)
+                {
+                    const size_t remaining = dimension - i;
+                    const __mmask16 mask = remaining >= 16 ?
+                                           static_cast<__mmask16>(0xFFFF) :
+                                           static_cast<__mmask16>((1u << remaining) - 1);
+                    const __m512 difference = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                                            _mm512_maskz_loadu_ps(mask, b + i));
+                    sum0 = _mm512_add_ps(sum0, _mm512_abs_ps(difference));
+                }
+                return horizontal_sum(_mm512_add_ps(sum0, sum1));
+            }
+            K_MEANS_SIMD_TARGET("avx512f")
+            inline void multiply_panel_avx512
+            (
+                const float* const* rows, const float* panel,
+                const size_t depth_begin, const size_t depth_end,
+                float* products, const size_t stride
+            )
+            {
+                __m512 row0_columns = _mm512_setzero_ps(), row1_columns = _mm512_setzero_ps(),
+                       row2_columns = _mm512_setzero_ps(), row3_columns = _mm512_setzero_ps();
+                const float *row0 = rows[0], *row1 = rows[1], *row2 = rows[2], *row3 = rows[3];
+                for (size_t d = depth_begin; d < depth_end; ++d)
+                {
+                    const __m512 columns = _mm512_loadu_ps(&panel[d * PANEL_WIDTH]);
+                    row0_columns = _mm512_fmadd_ps(_mm512_set1_ps(row0[d]), columns, row0_columns);
+                    row1_columns = _mm512_fmadd_ps(_mm512_set1_ps(row1[d]), columns, row1_columns);
+                    row2_columns = _mm512_fmadd_ps(_mm512_set1_ps(row2[d]), columns, row2_columns);
+                    row3_columns = _mm512_fmadd_ps(_mm512_set1_ps(row3[d]), columns, row3_columns);
+                }
+                const __m512 accumulators[PANEL_ROW_COUNT] = 
+                {
+                    row0_columns, row1_columns, row2_columns, row3_columns
+                };
+                for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+                {
+                    float* product = products + r * stride;
+                    _mm512_storeu_ps(product, _mm512_add_ps(_mm512_loadu_ps(product),
+                                                            accumulators[r]));
+                }
+            }
+            #endif  // K_MEANS_SIMD_AVX512
+            #endif  // K_MEANS_SIMD_X86
+
+            inline Kernels kernels_for(const InstructionSet instruction_set)
+            {
+                switch (instruction_set)
+                {
+                    #ifdef K_MEANS_SIMD_X86
+                    #ifdef K_MEANS_SIMD_AVX512
+                    case InstructionSet::avx512:
+                        return Kernels{instruction_set, euclidean2_avx512, manhattan_avx512,
+                                       multiply_panel_avx512};
+                    #endif
+                    case InstructionSet::avx2:
+                        return Kernels{instruction_set, euclidean2_avx2, manhattan_avx2,
+                                       multiply_panel_avx2};
+                    case InstructionSet::sse:
+                        return Kernels{instruction_set, euclidean2_sse, manhattan_sse,
+                                       multiply_panel_sse};
+                    #endif
+                    default:
+                        return Kernels{InstructionSet::scalar,
+                                       simd::euclidean2<float>,
+                                       simd::manhattan<float>,
+                                       multiply_panel_scalar};
+                }
+            }
+            inline Kernels& selected_kernels()
+            {
+                static Kernels kernels = kernels_for(supported_instruction_set());
+                return kernels;
+            }
+        }
+    }
+}
+
+
+inline cluster::simd::InstructionSet
+cluster::simd::supported_instruction_set()
+{
+    #ifdef K_MEANS_SIMD_X86
+    if (detail::max_cpuid_leaf() < 1) { return InstructionSet::scalar; }
+    unsigned int features[4];
+    detail::cpuid(1, 0, features);
+    const bool is_sse2 = (features[3] & (1u << 26)) != 0,
+               is_fma = (features[2] & (1u << 12)) != 0,
+               is_os_saving = (features[2] & (1u << 27)) != 0,
+               is_avx = (features[2] & (1u << 28)) != 0;
+    if (!is_sse2) { return InstructionSet::scalar; }
+    if (!is_os_saving || !is_avx || !is_fma || detail::max_cpuid_leaf() < 7)
+    {
+        return InstructionSet::sse;
+    }
+
+    // the operating system must also save the wider registers
+    const unsigned long long saved_state = detail::xgetbv();
+    unsigned int extended_features[4];
+    detail::cpuid(7, 0, extended_features);
+    const bool is_avx2 = (extended_features[1] & (1u << 5)) != 0,
+               is_avx512 = (extended_features[1] & (1u << 16)) != 0;
+    if (!is_avx2 || (saved_state & 0x6) != 0x6) { return InstructionSet::sse; }
+    #ifdef K_MEANS_SIMD_AVX512
+    if (is_avx512 && (saved_state & 0xE6) == 0xE6) { return InstructionSet::avx512; }
+    #else
+    (void) is_avx512;
+    #endif
+    return InstructionSet::avx2;
+    #else
+    return InstructionSet::scalar;
+    #endif
+}
+inline cluster::simd::InstructionSet
+cluster::simd::instruction_set()
+{
+    return detail::selected_kernels().instruction_set;
+}
+inline void
+cluster::simd::set_instruction_set(const InstructionSet instruction_set)
+{
+    if (instruction_set > supported_instruction_set())
+    {
+        throw std::invalid_argument("instruction set not supported");
+    }
+    detail::selected_kernels() = detail::kernels_for(instruction_set);
+}
+
+template<typename T>
+float cluster::simd::euclidean2
+(
+    const T* a, const T* b, const size_t dimension
+)
+{
+    float dot = 0;
+    for (size_t i = 0; i < dimension; ++i)
+    {
+        dot += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return dot;
+}
+inline float cluster::simd::euclidean2
+(
+    const float* a, const float* b, const size_t dimension
+)
+{
+    if (dimension < MIN_DIMENSION) { return euclidean2<float>(a, b, dimension); }
+    return detail::selected_kernels().euclidean2(a, b, dimension);
+}
+template<typename T>
+float cluster::simd::manhattan
+(
+    const T* a, const T* b, const size_t dimension
+)
+{
+    float sum = 0;
+    for (size_t i = 0; i < dimension; ++i)
+    {
+        sum += std::abs(a[i] - b[i]);
+    }
+    return sum;
+}
+inline float cluster::simd::manhattan
+(
+    const float* a, const float* b, const size_t dimension
+)
+{
+    if (dimension < MIN_DIMENSION) { return manhattan<float>(a, b, dimension); }
+    return detail::selected_kernels().manhattan(a, b, dimension);
+}
+inline void cluster::simd::multiply_panel
+(
+    const float* const* rows, const float* panel,
+    const size_t depth_begin, const size_t depth_end,
+    float* products, const size_t stride
+)
+{
+    detail::selected_kernels().multiply_panel(rows, panel, depth_begin, depth_end,
+                                              products, stride);
+}
@@ -0,0 +1,129 @@
+#ifndef K_MEANS_SIMD_H
+#define K_MEANS_SIMD_H
+/**
+ * @file simd.hpp
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-k-means-clustering
+ *
+ * Vectorized kernels.
+ */
+
+
+#include <cstddef>
+
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define K_MEANS_SIMD_X86
+    #if defined(__GNUC__) || (defined(_MSC_VER) && _MSC_VER >= 1911)
+        #define K_MEANS_SIMD_AVX512
+    #endif
+#endif
+
+
+namespace cluster
+{
+    /**
+     * Container for vectorized distance and matrix multiplication kernels.
+     *
+     * @details
+     *  Kernels for single-precision arrays are selected at run time, from the
+     *  widest instruction set supported by the processor and operating
+     *  system, so one binary runs at full speed on any x86 processor. On
+     *  other architectures, or for other data types, scalar loops are used.
+     *
+     *  The kernels sum in a different order than the scalar loops, so
+     *  results may differ by rounding between instruction sets.
+     */
+    namespace simd
+    {
+        /**
+         * Instruction sets, from narrowest to widest.
+         */
+        enum class InstructionSet
+        {
+            scalar,
+            sse,
+            avx2,
+            avx512
+        };
+
+        /**
+         * Number of rows multiplied at once by multiply_panel().
+         */
+        const size_t PANEL_ROW_COUNT = 4;
+        /**
+         * Number of columns in a panel of multiply_panel().
+         */
+        const size_t PANEL_WIDTH = 16;
+
+        /**
+         * Minimum dimension for which single-precision distances use the
+         * vectorized kernels. Shorter arrays use inlined scalar loops.
+         */
+        const size_t MIN_DIMENSION = 16;
+
+        /**
+         * Gets widest instruction set supported by the processor and
+         * operating system.
+         */
+        InstructionSet supported_instruction_set();
+        /**
+         * Gets instruction set of the kernels in use.
+         */
+        InstructionSet instruction_set();
+        /**
+         * Selects the kernels in use.
+         *
+         * @details
+         *  The widest supported instruction set is selected by default.
+         *  Not to be called while distances are being computed.
+         *
+         * @throws std::invalid_argument If the instruction set is not supported.
+         */
+        void set_instruction_set(InstructionSet instruction_set);
+
+        /**
+         * Computes Euclidean distance squared between arrays.
+         */
+        template<typename NumericType>
+        float euclidean2(const NumericType* a, const NumericType* b, size_t dimension);
+        /**
+         * Computes Euclidean distance squared between single-precision
+         * arrays, using the kernels in use.
+         */
+        float euclidean2(const float* a, const float* b, size_t dimension);
+        /**
+         * Computes Manhattan distance between arrays.
+         */
+        template<typename NumericType>
+        float manhattan(const NumericType* a, const NumericType* b, size_t dimension);
+        /**
+         * Computes Manhattan distance between single-precision arrays,
+         * using the kernels in use.
+         */
+        float manhattan(const float* a, const float* b, size_t dimension);
+
+        /**
+         * Adds the products of PANEL_ROW_COUNT rows with a panel of 
+         * PANEL_WIDTH columns, over depths [depth_begin, depth_end), using the
+         * kernels in use.
+         *
+         * @details This is the micro-kernel of a matrix multiplication.
+         *
+         * @param rows     Pointers to the rows.
+         * @param panel    Columns, stored depth by depth: the value of column c
+         *                 at depth d is panel[d * PANEL_WIDTH + c].
+         * @param products Row-major products to add to.
+         * @param stride   Distance between rows of products.
+         */
+        void multiply_panel(const float* const* rows, const float* panel,
+                            size_t depth_begin, size_t depth_end,
+                            float* products, size_t stride);
+    }
+}
+
+
+#include "simd.cpp"
+
+
+#endif  // K_MEANS_SIMD_H
@@ -194,7 +194,8 @@ std::vector<Vector<NumericType, Dimension>> run_and_record
     kMeans<NumericType, Dimension, Distance> solver
     (
         cluster_count, 
-        &observations[0], observations.size()
+        &observations[0], observations.size(),
+        borrow
     );
     solver.initialize(&initial_means[0]);
     for (size_t j = 0; j < cluster_count; ++j)
@@ -32,3 +32,24 @@ TEST_CASE("distance: manhattan",
     REQUIRE(dist(a, b) == dist(b, a));
     REQUIRE(dist(a, b) == 7);
 }
+
+TEST_CASE("distance: arrays", 
+          "[distance-functions]")
+{
+    const float a[] = {0.0f, 0.0f, 0.0f},
+                b[] = {3.0f, 4.0f, 12.0f};
+
+    REQUIRE(euclidean2(a, b, 3) == 169);
+    REQUIRE(euclidean2(a, b, 2) == 25);
+    REQUIRE(manhattan(a, b, 3) == 19);
+    REQUIRE(manhattan(b, b, 3) == 0);
+}
+
+TEST_CASE("distance: identity", 
+          "[distance-functions]")
+{
+    REQUIRE((is_euclidean2<float, 2, &euclidean2<float, 2>>::value));
+    REQUIRE((!is_euclidean2<float, 2, &manhattan<float, 2>>::value));
+    REQUIRE((is_manhattan<float, 2, &manhattan<float, 2>>::value));
+    REQUIRE((!is_manhattan<double, 2, &euclidean2<double, 2>>::value));
+}
@@ -0,0 +1,54 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/parallel.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+using namespace cluster::parallel;
+
+
+TEST_CASE("parallel: worker count", "[parallel][parallel-worker-count]")
+{
+    REQUIRE(worker_count(0, 4) == 1);
+    REQUIRE(worker_count(2, 4) == 2);
+    REQUIRE(worker_count(100, 4) == 4);
+    REQUIRE(worker_count(100, 0) == std::min<size_t>(100, hardware_thread_count()));
+}
+
+TEST_CASE("parallel: for each range", "[parallel][parallel-for-each-range]")
+{
+    const size_t n = 103, workers = 4;
+    std::vector<size_t> visits(n, 0);
+    std::vector<size_t> range_owners(n, workers);
+    for_each_range
+    (
+        n, workers,
+        [&visits, &range_owners](size_t worker, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                ++ visits[i];
+                range_owners[i] = worker;
+            }
+        }
+    );
+    for (size_t i = 0; i < n; ++i)
+    {
+        REQUIRE(visits[i] == 1);
+        REQUIRE(range_owners[i] < workers);
+    }
+    REQUIRE(std::is_sorted(range_owners.begin(), range_owners.end()));
+}
+
+TEST_CASE("parallel: reduce", "[parallel][parallel-reduce]")
+{
+    for (size_t count = 1; count <= 9; ++count)
+    {
+        std::vector<size_t> partials(count);
+        for (size_t i = 0; i < count; ++i) { partials[i] = i + 1; }
+        reduce(partials, [](size_t& lhs, size_t rhs) { lhs += rhs; });
+
+        REQUIRE(partials.front() == count * (count + 1) / 2);
+    }
+}
@@ -0,0 +1,122 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/random.hpp"
+#include "../../core/include/seeder.hpp"
+
+#include <vector>
+
+
+using namespace cluster::random;
+
+
+TEST_CASE("random: engine", "[random][random-engine]")
+{
+    Engine a(42), b(42), c(43);
+    std::vector<Engine::result_type> a_values, b_values, c_values;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        a_values.push_back(a());
+        b_values.push_back(b());
+        c_values.push_back(c());
+    }
+    REQUIRE(a_values == b_values);
+    REQUIRE(a_values != c_values);
+
+    SECTION("jump")
+    {
+        Engine jumped = a;
+        jumped.jump();
+        REQUIRE(jumped() != a());
+    }
+}
+
+TEST_CASE("random: in range", "[random][random-in-range]")
+{
+    Engine engine(7);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const int integer = int_in_range(engine, -3, 3);
+        const double real = real_in_range(engine, 1.0, 2.0);
+        REQUIRE(integer >= -3);
+        REQUIRE(integer <= 3);
+        REQUIRE(real >= 1.0);
+        REQUIRE(real < 2.0);
+    }
+}
+
+TEST_CASE("random: streams", "[random][random-streams]")
+{
+    seed(42);
+    std::vector<Engine> first = streams(3);
+    const size_t next = int_in_range<size_t>(0, 1000000);
+    seed(42);
+    std::vector<Engine> second = streams(3);
+
+    REQUIRE(int_in_range<size_t>(0, 1000000) == next);
+    std::vector<Engine::result_type> first_values, second_values;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        first_values.push_back(first[i]());
+        second_values.push_back(second[i]());
+    }
+    REQUIRE(first_values == second_values);
+    REQUIRE(first_values[0] != first_values[1]);
+    REQUIRE(first_values[1] != first_values[2]);
+}
+
+TEST_CASE("random: reproducible seeding", "[random][random-seeding]")
+{
+    // several blocks of seeding passes, so that workers split them
+    typedef cluster::Vector<float, 1> Vector1;
+    const size_t n = 50000, k = 8;
+    std::vector<Vector1> observations(n);
+    std::vector<float> weights(n);
+    for (size_t i = 0; i < observations.size(); ++i)
+    {
+        observations[i] = Vector1{static_cast<float>(i % 997)};
+        weights[i] = static_cast<float>(1 + i % 5) * 0.1f;
+    }
+    std::vector<Vector1> first(k), second(k);
+
+    SECTION("k-means++")
+    {
+        seed(7);
+        cluster::seeder::k_means_plus_plus<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), first.begin(), 1
+        );
+        seed(7);
+        cluster::seeder::k_means_plus_plus<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), second.begin(), 3
+        );
+        REQUIRE(first == second);
+    }
+    SECTION("k-means||")
+    {
+        seed(7);
+        cluster::seeder::k_means_parallel<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), first.begin(), 1
+        );
+        seed(7);
+        cluster::seeder::k_means_parallel<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), second.begin(), 3
+        );
+        REQUIRE(first == second);
+    }
+    SECTION("AFK-MC^2")
+    {
+        seed(7);
+        cluster::seeder::afk_mc2<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), first.begin(), 1
+        );
+        seed(7);
+        cluster::seeder::afk_mc2<float, 1>
+        (
+            k, observations.begin(), observations.end(), weights.begin(), second.begin(), 3
+        );
+        REQUIRE(first == second);
+    }
+}
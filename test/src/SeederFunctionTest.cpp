@@ -1,6 +1,9 @@
 #include "../lib/catch.hpp"
 #include "../../core/include/seeder.hpp"
+#include "../../core/include/random.hpp"
 
+#include <algorithm>
+#include <forward_list>
 #include <vector>
 
 
@@ -54,3 +57,354 @@ TEST_CASE("seeder: random-partition",
     REQUIRE(result.size() == 1);
     REQUIRE(result.at(0) == expected_result);
 }
+
+TEST_CASE("seeder: weighted", 
+          "[seeder-functions][seeder-weighted]")
+{
+    Vector1 observations[2]
+    {
+        Vector1{0.0f},
+        Vector1{10.0f}
+    };
+    std::vector<Vector1> result(2);
+
+    SECTION("forgy")
+    {
+        const float weights[2] { 0.0f, 1.0f };
+        forgy<float, 1>
+        (
+            2, 
+            &observations[0], &observations[2],
+            &weights[0],
+            result.begin()
+        );
+        REQUIRE(result.at(0) == observations[1]);
+        REQUIRE(result.at(1) == observations[1]);
+    }
+    SECTION("random partition")
+    {
+        const float weights[2] { 1.0f, 3.0f };
+        random_partition<float, 1>
+        (
+            1, 
+            &observations[0], &observations[2],
+            &weights[0],
+            result.begin()
+        );
+        REQUIRE(result.at(0) == Vector1{7.5f});
+    }
+}
+
+TEST_CASE("seeder: single pass", 
+          "[seeder-functions][seeder-single-pass]")
+{
+    // forward iterators only, so the seeders cannot index the range
+    const std::forward_list<Vector1> observations
+    {
+        Vector1{0.0f},
+        Vector1{10.0f},
+        Vector1{20.0f}
+    };
+    std::vector<Vector1> result(3);
+
+    SECTION("forgy")
+    {
+        forgy<float, 1>
+        (
+            3, 
+            observations.begin(), observations.end(),
+            result.begin()
+        );
+        std::sort(result.begin(), result.end(), 
+                  [](const Vector1& a, const Vector1& b) { return a[0] < b[0]; });
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{10.0f});
+        REQUIRE(result.at(2) == Vector1{20.0f});
+    }
+    SECTION("weighted forgy")
+    {
+        const std::forward_list<float> weights { 0.0f, 1.0f, 2.0f };
+        forgy<float, 1>
+        (
+            2, 
+            observations.begin(), observations.end(),
+            weights.begin(),
+            result.begin()
+        );
+        REQUIRE(result.at(0) != Vector1{0.0f});
+        REQUIRE(result.at(1) != Vector1{0.0f});
+        REQUIRE(result.at(0) != result.at(1));
+    }
+    SECTION("random partition")
+    {
+        random_partition<float, 1>
+        (
+            1, 
+            observations.begin(), observations.end(),
+            result.begin()
+        );
+        REQUIRE(result.at(0) == Vector1{10.0f});
+    }
+}
+
+TEST_CASE("seeder: degenerate input", 
+          "[seeder-functions][seeder-degenerate]")
+{
+    const std::vector<Vector1> observations { Vector1{4.0f}, Vector1{6.0f} };
+    const std::vector<float> zero_weights(observations.size(), 0.0f);
+    std::vector<Vector1> result(2, Vector1{1.0f});
+
+    SECTION("no clusters")
+    {
+        forgy<float, 1>(0, observations.begin(), observations.end(), result.begin());
+        forgy<float, 1>(0, observations.begin(), observations.end(), 
+                        zero_weights.begin(), result.begin());
+        random_partition<float, 1>(0, observations.begin(), observations.end(), 
+                                   result.begin());
+        random_partition<float, 1>(0, observations.begin(), observations.end(), 
+                                   zero_weights.begin(), result.begin());
+        k_means_plus_plus<float, 1>(0, observations.begin(), observations.end(), 
+                                    result.begin());
+        k_means_parallel<float, 1>(0, observations.begin(), observations.end(), 
+                                   result.begin());
+        afk_mc2<float, 1>(0, observations.begin(), observations.end(), result.begin());
+        REQUIRE(result.at(0) == Vector1{1.0f});
+        REQUIRE(result.at(1) == Vector1{1.0f});
+    }
+    SECTION("no observations")
+    {
+        forgy<float, 1>(2, observations.end(), observations.end(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+
+        result.assign(2, Vector1{1.0f});
+        k_means_plus_plus<float, 1>(2, observations.end(), observations.end(), 
+                                    result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+
+        result.assign(2, Vector1{1.0f});
+        k_means_parallel<float, 1>(2, observations.end(), observations.end(), 
+                                   zero_weights.begin(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+
+        result.assign(2, Vector1{1.0f});
+        afk_mc2<float, 1>(2, observations.end(), observations.end(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+
+        result.assign(2, Vector1{1.0f});
+        afk_mc2<float, 1>(2, observations.end(), observations.end(), 
+                          zero_weights.begin(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+    }
+    SECTION("zero weights")
+    {
+        forgy<float, 1>(2, observations.begin(), observations.end(), 
+                        zero_weights.begin(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+
+        random_partition<float, 1>(2, observations.begin(), observations.end(), 
+                                   zero_weights.begin(), result.begin());
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{0.0f});
+    }
+}
+
+TEST_CASE("seeder: k-means++", 
+          "[seeder-functions][seeder-k-means-plus-plus]")
+{
+    // two groups of coincident observations, large enough for several workers
+    const size_t n = 100000;
+    std::vector<Vector1> observations(n, Vector1{0.0f});
+    std::fill(observations.begin() + n / 3, observations.end(), Vector1{10.0f});
+    std::vector<Vector1> result(2);
+
+    SECTION("unweighted")
+    {
+        k_means_plus_plus<float, 1>
+        (
+            2, 
+            observations.begin(), observations.end(),
+            result.begin()
+        );
+        // once one group holds a mean, only the other has positive distance
+        REQUIRE(result.at(0) != result.at(1));
+    }
+    SECTION("weighted")
+    {
+        std::vector<float> weights(n, 1.0f);
+        std::fill(weights.begin(), weights.begin() + n / 3, 0.0f);
+        observations[n - 1] = Vector1{20.0f};
+        k_means_plus_plus<float, 1>
+        (
+            2, 
+            observations.begin(), observations.end(),
+            weights.begin(),
+            result.begin()
+        );
+        REQUIRE(result.at(0) != Vector1{0.0f});
+        REQUIRE(result.at(1) != Vector1{0.0f});
+        REQUIRE(result.at(0) != result.at(1));
+    }
+}
+
+TEST_CASE("seeder: k-means||", 
+          "[seeder-functions][seeder-k-means-parallel]")
+{
+    // three groups of coincident observations
+    const size_t n = 60000;
+    std::vector<Vector1> observations(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        observations[i] = Vector1{10.0f * static_cast<float>(i % 3)};
+    }
+    std::vector<Vector1> result(3);
+
+    SECTION("unweighted")
+    {
+        k_means_parallel<float, 1>
+        (
+            3, 
+            observations.begin(), observations.end(),
+            result.begin()
+        );
+        std::sort(result.begin(), result.end(), 
+                  [](const Vector1& a, const Vector1& b) { return a[0] < b[0]; });
+        REQUIRE(result.at(0) == Vector1{0.0f});
+        REQUIRE(result.at(1) == Vector1{10.0f});
+        REQUIRE(result.at(2) == Vector1{20.0f});
+    }
+    SECTION("weighted")
+    {
+        std::vector<float> weights(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            weights[i] = i % 3 == 0 ? 0.0f : 1.0f;
+        }
+        k_means_parallel<float, 1>
+        (
+            2, 
+            observations.begin(), observations.end(),
+            weights.begin(),
+            result.begin()
+        );
+        REQUIRE(result.at(0) != Vector1{0.0f});
+        REQUIRE(result.at(1) != Vector1{0.0f});
+        REQUIRE(result.at(0) != result.at(1));
+    }
+}
+
+TEST_CASE("seeder: AFK-MC^2", 
+          "[seeder-functions][seeder-afk-mc2]")
+{
+    // three groups of coincident observations
+    const size_t n = 60000;
+    std::vector<Vector1> observations(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        observations[i] = Vector1{10.0f * static_cast<float>(i % 3)};
+    }
+    std::vector<Vector1> result(3);
+
+    SECTION("unweighted")
+    {
+        afk_mc2<float, 1>
+        (
+            3, 
+            observations.begin(), observations.end(),
+            result.begin()
+        );
+        // proposals from a covered group are never accepted over the rest
+        REQUIRE(result.at(0) != result.at(1));
+        REQUIRE(result.at(0) != result.at(2));
+        REQUIRE(result.at(1) != result.at(2));
+    }
+    SECTION("weighted")
+    {
+        std::vector<float> weights(n, 1.0f);
+        for (size_t i = 0; i < n; i += 3) { weights[i] = 0.0f; }
+        afk_mc2<float, 1>
+        (
+            2, 
+            observations.begin(), observations.end(),
+            weights.begin(),
+            result.begin()
+        );
+        REQUIRE(result.at(0) != Vector1{0.0f});
+        REQUIRE(result.at(1) != Vector1{0.0f});
+        REQUIRE(result.at(0) != result.at(1));
+    }
+    SECTION("fractional weights")
+    {
+        // the far group is light enough that its weighted distance is a 
+        // small share, though its distance alone is by far the largest
+        std::vector<float> weights(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float weight_by_group[3] { 2.0f, 3.0f, 5e-4f };
+            weights[i] = weight_by_group[i % 3];
+            if (i % 3 == 2) { observations[i] = Vector1{100.0f}; }
+        }
+        cluster::random::seed(3);
+        size_t far_count = 0;
+        for (size_t run = 0; run < 20; ++run)
+        {
+            afk_mc2<float, 1>
+            (
+                2, 
+                observations.begin(), observations.end(),
+                weights.begin(),
+                result.begin()
+            );
+            if (result.at(1) == Vector1{100.0f}) { ++ far_count; }
+        }
+        REQUIRE(far_count <= 3);
+    }
+}
+
+TEST_CASE("seeder: thread count", 
+          "[seeder-functions][seeder-thread-count]")
+{
+    // three groups of coincident observations
+    const size_t n = 60000;
+    std::vector<Vector1> observations(n);
+    std::vector<float> weights(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        observations[i] = Vector1{10.0f * static_cast<float>(i % 3)};
+        weights[i] = static_cast<float>(1 + i % 2);
+    }
+    const auto is_spread = [](std::vector<Vector1> means)
+    {
+        std::sort(means.begin(), means.end(), 
+                  [](const Vector1& a, const Vector1& b) { return a[0] < b[0]; });
+        return means.at(0) == Vector1{0.0f} && 
+               means.at(1) == Vector1{10.0f} && 
+               means.at(2) == Vector1{20.0f};
+    };
+    std::vector<Vector1> result(3);
+
+    // an int thread count must not be taken for an output iterator
+    k_means_plus_plus<float, 1>(3, observations.begin(), observations.end(), 
+                                result.begin(), 2);
+    REQUIRE(is_spread(result));
+    k_means_plus_plus<float, 1>(3, observations.begin(), observations.end(), 
+                                weights.begin(), result.begin(), 2);
+    REQUIRE(is_spread(result));
+    k_means_parallel<float, 1>(3, observations.begin(), observations.end(), 
+                               result.begin(), 3);
+    REQUIRE(is_spread(result));
+    k_means_parallel<float, 1>(3, observations.begin(), observations.end(), 
+                               weights.begin(), result.begin(), 1);
+    REQUIRE(is_spread(result));
+    afk_mc2<float, 1>(3, observations.begin(), observations.end(), 
+                      result.begin(), 2);
+    REQUIRE(is_spread(result));
+    afk_mc2<float, 1>(3, observations.begin(), observations.end(), 
+                      weights.begin(), result.begin(), 0);
+    REQUIRE(is_spread(result));
+}
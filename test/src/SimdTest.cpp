@@ -0,0 +1,106 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/simd.hpp"
+#include "fixtures.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+using namespace cluster::simd;
+
+
+TEST_CASE("simd: kernels", "[simd]")
+{
+    const InstructionSet initial = instruction_set();
+    REQUIRE(initial == supported_instruction_set());
+
+    std::vector<float> a(1000), b(1000);
+    fixtures::Lcg generator(5);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<float>(generator.next() % 1000) * 0.01f - 5.0f;
+        b[i] = static_cast<float>(generator.next() % 1000) * 0.01f - 5.0f;
+    }
+
+    const InstructionSet instruction_sets[] = 
+    {
+        InstructionSet::scalar, InstructionSet::sse, 
+        InstructionSet::avx2, InstructionSet::avx512
+    };
+    const size_t dimensions[] = {1, 15, 16, 17, 31, 40, 64, 100, 768, 1000};
+    for (const InstructionSet selected : instruction_sets)
+    {
+        if (selected > supported_instruction_set()) { continue; }
+        set_instruction_set(selected);
+        REQUIRE(instruction_set() == selected);
+        for (const size_t dimension : dimensions)
+        {
+            const float expected_euclidean2 = euclidean2<float>(&a[0], &b[0], dimension),
+                        expected_manhattan = manhattan<float>(&a[0], &b[0], dimension);
+            REQUIRE(std::abs(euclidean2(&a[0], &b[0], dimension) - expected_euclidean2) <= 
+                    1e-5f * expected_euclidean2);
+            REQUIRE(std::abs(manhattan(&a[0], &b[0], dimension) - expected_manhattan) <= 
+                    1e-5f * expected_manhattan);
+            REQUIRE(euclidean2(&a[0], &a[0], dimension) == 0);
+            REQUIRE(manhattan(&b[0], &b[0], dimension) == 0);
+        }
+    }
+    set_instruction_set(InstructionSet::scalar);
+    REQUIRE(euclidean2(&a[0], &b[0], 100) == euclidean2<float>(&a[0], &b[0], 100));
+    set_instruction_set(initial);
+}
+
+TEST_CASE("simd: panel multiplication", "[simd]")
+{
+    const InstructionSet initial = instruction_set();
+    const size_t depth = 37, stride = PANEL_WIDTH + 3;
+
+    std::vector<float> matrix(PANEL_ROW_COUNT * depth), panel(depth * PANEL_WIDTH);
+    for (size_t i = 0; i < matrix.size(); ++i)
+    {
+        matrix[i] = static_cast<float>(i % 7) - 3.0f;
+    }
+    for (size_t i = 0; i < panel.size(); ++i)
+    {
+        panel[i] = static_cast<float>(i % 5) * 0.5f;
+    }
+    const float* rows[PANEL_ROW_COUNT];
+    for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+    {
+        rows[r] = &matrix[r * depth];
+    }
+
+    const InstructionSet instruction_sets[] = 
+    {
+        InstructionSet::scalar, InstructionSet::sse, 
+        InstructionSet::avx2, InstructionSet::avx512
+    };
+    for (const InstructionSet selected : instruction_sets)
+    {
+        if (selected > supported_instruction_set()) { continue; }
+        set_instruction_set(selected);
+
+        // products are added to, over two slices of depth
+        std::vector<float> products(PANEL_ROW_COUNT * stride, 1.0f);
+        multiply_panel(rows, &panel[0], 0, 20, &products[0], stride);
+        multiply_panel(rows, &panel[0], 20, depth, &products[0], stride);
+        for (size_t r = 0; r < PANEL_ROW_COUNT; ++r)
+        {
+            for (size_t c = 0; c < PANEL_WIDTH; ++c)
+            {
+                float expected = 1.0f;
+                for (size_t d = 0; d < depth; ++d)
+                {
+                    expected += rows[r][d] * panel[d * PANEL_WIDTH + c];
+                }
+                // small integers and halves, so exact in any order
+                REQUIRE(products[r * stride + c] == expected);
+            }
+            for (size_t c = PANEL_WIDTH; c < stride; ++c)
+            {
+                REQUIRE(products[r * stride + c] == 1.0f);
+            }
+        }
+    }
+    set_instruction_set(initial);
+}
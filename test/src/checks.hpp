@@ -0,0 +1,217 @@
+#ifndef K_MEANS_TEST_CHECKS_H
+#define K_MEANS_TEST_CHECKS_H
+/**
+ * @file checks.hpp
+ *
+ * Checks shared by the tests of engines that must match exhaustive kMeans.
+ */
+
+
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeans.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+
+namespace checks
+{
+    typedef cluster::Vector<float, 2> Vector2;
+
+    /**
+     * Totals over the steps of require_exhaustive_steps().
+     */
+    struct StepTotals
+    {
+        size_t distances;             // calls to counted_euclidean2 by the solver
+        size_t exhaustive_distances;  // calls to counted_euclidean2 by kMeans
+        size_t empty_clusters;        // summed over all but the first assignment
+    };
+
+    /**
+     * Steps a solver alongside exhaustive kMeans from the same means, and
+     * requires the same assignment, inertia and means at every step.
+     */
+    template<typename Solver, typename Exhaustive>
+    StepTotals require_exhaustive_steps(Solver& solver, Exhaustive& exhaustive,
+                                        const size_t max_iterations)
+    {
+        StepTotals totals{0, 0, 0};
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            fixtures::distance_count() = 0;
+            const bool is_exhaustive_changed = exhaustive.assign();
+            totals.exhaustive_distances += fixtures::distance_count();
+
+            fixtures::distance_count() = 0;
+            const bool is_changed = solver.assign();
+            totals.distances += fixtures::distance_count();
+
+            REQUIRE(is_changed == is_exhaustive_changed);
+            for (size_t i = 0; i < exhaustive.n(); ++i)
+            {
+                REQUIRE(solver.cluster(i) == exhaustive.cluster(i));
+            }
+            for (size_t j = 0; j < exhaustive.k(); ++j)
+            {
+                REQUIRE(solver.cluster_size(j) == exhaustive.cluster_size(j));
+                if (iteration > 0 && exhaustive.cluster_size(j) == 0)
+                {
+                    ++ totals.empty_clusters;
+                }
+            }
+            REQUIRE(solver.inertia() == Approx(exhaustive.inertia()));
+            if (!is_exhaustive_changed) { break; }
+
+            exhaustive.update();
+            solver.update();
+            for (size_t j = 0; j < exhaustive.k(); ++j)
+            {
+                REQUIRE(solver.mean(j) == exhaustive.mean(j));
+            }
+        }
+        return totals;
+    }
+
+    /**
+     * Runs a solver and exhaustive kMeans from the same means, and
+     * requires the same iteration count, assignment and inertia.
+     *
+     * @return Number of iterations.
+     */
+    template<typename Solver, typename Exhaustive>
+    size_t require_exhaustive_run(Solver& solver, Exhaustive& exhaustive,
+                                  const size_t max_iterations)
+    {
+        const size_t iteration_count = exhaustive.run(max_iterations);
+        REQUIRE(solver.run(max_iterations) == iteration_count);
+        for (size_t i = 0; i < exhaustive.n(); ++i)
+        {
+            REQUIRE(solver.cluster(i) == exhaustive.cluster(i));
+        }
+        REQUIRE(solver.inertia() == Approx(exhaustive.inertia()));
+        return iteration_count;
+    }
+
+    /**
+     * Leaves an engine as constructed.
+     */
+    struct Unconfigured
+    {
+        template<typename Solver>
+        void operator()(Solver&) const {}
+    };
+
+    /**
+     * Requires an engine that skips distance computations by bounds to
+     * match exhaustive kMeans, and to compute fewer distances.
+     *
+     * @details
+     *  Covers stepping, running on several threads, manhattan distance,
+     *  the inertia tolerance and the repair of empty clusters, each in its
+     *  own section.
+     *
+     * @tparam Engine    Engine template, such as cluster::kMeansHamerly.
+     * @tparam Configure Callable on an instance of Engine of any distance.
+     *
+     * @param k         Number of clusters.
+     * @param configure Applied to every engine before it is initialized.
+     */
+    template<template<typename T, size_t D, cluster::DistanceFunction<T, D> Distance>
+             class Engine,
+             typename Configure = Unconfigured>
+    void require_exhaustive_results(const size_t k, Configure configure = Configure())
+    {
+        using cluster::borrow;
+        using cluster::kMeans;
+        using fixtures::counted_euclidean2;
+        namespace distance = cluster::distance;
+
+        const size_t n = 2000, max_iterations = 30;
+        const std::vector<Vector2> observations = fixtures::square_observations(n, 1);
+
+        SECTION("steps")
+        {
+            kMeans<float, 2, counted_euclidean2<float, 2>> exhaustive(k, &observations[0], n,
+                                                                      borrow);
+            Engine<float, 2, counted_euclidean2<float, 2>> engine(k, &observations[0], n,
+                                                                  borrow);
+            configure(engine);
+            exhaustive.initialize(&observations[0]);
+            engine.initialize(&observations[0]);
+
+            const StepTotals totals = require_exhaustive_steps(engine, exhaustive,
+                                                               max_iterations);
+            REQUIRE(totals.distances < totals.exhaustive_distances);
+        }
+        SECTION("parallel")
+        {
+            kMeans<float, 2, distance::euclidean2<float, 2>> exhaustive(k, &observations[0], n,
+                                                                        borrow);
+            Engine<float, 2, distance::euclidean2<float, 2>> engine(k, &observations[0], n,
+                                                                    borrow);
+            configure(engine);
+            exhaustive.initialize(&observations[0]);
+            engine.initialize(&observations[0]);
+            engine.set_thread_count(4);
+
+            require_exhaustive_run(engine, exhaustive, max_iterations);
+        }
+        SECTION("manhattan")
+        {
+            kMeans<float, 2, distance::manhattan<float, 2>> exhaustive(k, &observations[0], n,
+                                                                       borrow);
+            Engine<float, 2, distance::manhattan<float, 2>> engine(k, &observations[0], n,
+                                                                   borrow);
+            configure(engine);
+            exhaustive.initialize(&observations[0]);
+            engine.initialize(&observations[0]);
+
+            require_exhaustive_run(engine, exhaustive, max_iterations);
+        }
+        SECTION("tolerances")
+        {
+            // the inertia tolerance must see exact inertia, not the bounds
+            kMeans<float, 2, distance::euclidean2<float, 2>> exhaustive(k, &observations[0], n,
+                                                                        borrow);
+            Engine<float, 2, distance::euclidean2<float, 2>> engine(k, &observations[0], n,
+                                                                    borrow);
+            configure(engine);
+            exhaustive.initialize(&observations[0]);
+            engine.initialize(&observations[0]);
+            exhaustive.set_inertia_tolerance(1e-3f);
+            engine.set_inertia_tolerance(1e-3f);
+
+            REQUIRE(require_exhaustive_run(engine, exhaustive, max_iterations) < 
+                    max_iterations);
+        }
+        SECTION("empty clusters")
+        {
+            // means start in two columns at the left edge; some empty
+            // mid-run, when the bounds are loose, and are repaired as by
+            // exhaustive kMeans
+            const size_t column_k = 40, column_n = 400;
+            const std::vector<Vector2> column_observations =
+                fixtures::square_observations(column_n, 8);
+            std::vector<Vector2> initial_means;
+            for (size_t j = 0; j < column_k; ++j)
+            {
+                initial_means.push_back(Vector2{static_cast<float>(j % 2),
+                                                static_cast<float>(j / 2) * 50.0f});
+            }
+            kMeans<float, 2, distance::euclidean2<float, 2>>
+                exhaustive(column_k, &column_observations[0], column_n, borrow);
+            Engine<float, 2, distance::euclidean2<float, 2>>
+                engine(column_k, &column_observations[0], column_n, borrow);
+            configure(engine);
+            exhaustive.initialize(&initial_means[0]);
+            engine.initialize(&initial_means[0]);
+
+            const StepTotals totals = require_exhaustive_steps(engine, exhaustive, 50);
+            REQUIRE(totals.empty_clusters > 0);
+        }
+    }
+}
+
+
+#endif  // K_MEANS_TEST_CHECKS_H
@@ -0,0 +1,80 @@
+#ifndef K_MEANS_TEST_FIXTURES_H
+#define K_MEANS_TEST_FIXTURES_H
+/**
+ * @file fixtures.hpp
+ *
+ * Data and instrumentation shared by the tests.
+ */
+
+
+#include "../../core/include/distance.hpp"
+#include "../../core/include/Vector.hpp"
+
+#include <vector>
+
+
+namespace fixtures
+{
+    /**
+     * Linear congruential generator, so that test data is the same on
+     * every platform and standard library.
+     */
+    class Lcg
+    {
+        public:
+        explicit Lcg(const unsigned int seed) : state_(seed) {}
+
+        /**
+         * Gets the next value, in [0, 2^16).
+         */
+        unsigned int next()
+        {
+            state_ = state_ * 1103515245u + 12345u;
+            return state_ >> 16;
+        }
+
+        private:
+        unsigned int state_;
+    };
+
+    /**
+     * Gets points with integral coordinates drawn uniformly from
+     * [0, 1000)^2.
+     */
+    inline std::vector<cluster::Vector<float, 2>> square_observations(const size_t n,
+                                                                     const unsigned int seed)
+    {
+        std::vector<cluster::Vector<float, 2>> observations;
+        Lcg generator(seed);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float x = static_cast<float>(generator.next() % 1000);
+            const float y = static_cast<float>(generator.next() % 1000);
+            observations.push_back(cluster::Vector<float, 2>{x, y});
+        }
+        return observations;
+    }
+
+    /**
+     * Gets the number of calls to counted_euclidean2 so far. Tests reset
+     * it before counting.
+     */
+    inline size_t& distance_count()
+    {
+        static size_t count = 0;
+        return count;
+    }
+
+    /**
+     * distance::euclidean2 that counts its calls in distance_count().
+     */
+    template<typename T, size_t D>
+    float counted_euclidean2(const cluster::Vector<T, D>& a, const cluster::Vector<T, D>& b)
+    {
+        ++ distance_count();
+        return cluster::distance::euclidean2<T, D>(a, b);
+    }
+}
+
+
+#endif  // K_MEANS_TEST_FIXTURES_H
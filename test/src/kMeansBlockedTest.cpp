@@ -0,0 +1,66 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansBlocked.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 3> Vector3;
+
+TEST_CASE("kMeansBlocked", "[kMeansBlocked]")
+{
+    const size_t k = 7, n = 1001, max_iterations = 30;
+    std::vector<Vector3> observations;
+    fixtures::Lcg generator(3);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vector3 obs;
+        for (size_t d = 0; d < 3; ++d)
+        {
+            obs[d] = static_cast<float>(generator.next() % 1000) * 0.37f;
+        }
+        observations.push_back(obs);
+    }
+
+    SECTION("euclidean2")
+    {
+        kMeans<float, 3, distance::euclidean2<float, 3>> 
+            exhaustive(k, &observations[0], n);
+        kMeansBlocked<float, 3, distance::euclidean2<float, 3>> 
+            blocked(k, &observations[0], n, borrow);
+        exhaustive.initialize(&observations[0]);
+        blocked.initialize(&observations[0]);
+        blocked.set_thread_count(3);
+
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            const bool is_changed = exhaustive.assign();
+            REQUIRE(blocked.assign() == is_changed);
+            for (size_t i = 0; i < n; ++i)
+            {
+                REQUIRE(blocked.cluster(i) == exhaustive.cluster(i));
+            }
+            if (!is_changed) { break; }
+            exhaustive.update();
+            blocked.update();
+        }
+    }
+    SECTION("manhattan")
+    {
+        kMeans<float, 3, distance::manhattan<float, 3>> 
+            exhaustive(k, &observations[0], n);
+        kMeansBlocked<float, 3, distance::manhattan<float, 3>> 
+            blocked(k, &observations[0], n);
+        exhaustive.initialize(&observations[0]);
+        blocked.initialize(&observations[0]);
+        
+        REQUIRE(blocked.run(max_iterations) == exhaustive.run(max_iterations));
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(blocked.cluster(i) == exhaustive.cluster(i));
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansCompressed.hpp"
+#include "fixtures.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 4> Vector4;
+
+namespace
+{
+    template<typename Codec>
+    float round_trip(const Codec& codec, const float value)
+    {
+        typename Codec::Code code;
+        Vector<float, 1> obs{value};
+        codec.encode(obs, &code);
+        codec.decode(&code, obs);
+        return obs[0];
+    }
+    template<typename Codec>
+    typename Codec::Code encode(const Codec& codec, const float value)
+    {
+        typename Codec::Code code;
+        codec.encode(Vector<float, 1>{value}, &code);
+        return code;
+    }
+}
+
+TEST_CASE("codec", "[codec]")
+{
+    const float values[] = {0.0f, -0.0f, 1.0f, -2.5f, 3.140625f, 1e-6f, 
+                            65504.0f, -1e30f};
+
+    SECTION("bfloat16")
+    {
+        const codec::BFloat16<1> bfloat16;
+        for (const float value : values)
+        {
+            REQUIRE(std::abs(round_trip(bfloat16, value) - value) <= std::abs(value) / 256);
+        }
+        // ties round to even
+        REQUIRE(round_trip(bfloat16, 1.0f + 1.0f / 256) == 1.0f);
+        REQUIRE(std::isnan(round_trip(bfloat16, std::numeric_limits<float>::quiet_NaN())));
+    }
+    SECTION("half")
+    {
+        const codec::Half<1> half;
+        for (const float value : values)
+        {
+            const float decoded = round_trip(half, value);
+            if (std::abs(value) > 65504.0f)
+            {
+                REQUIRE(std::isinf(decoded));
+            }
+            else
+            {
+                // subnormals keep absolute precision 2^-24
+                REQUIRE(std::abs(decoded - value) <= 
+                        std::max(std::abs(value) / 2048, 1.0f / (1 << 24)));
+            }
+        }
+        REQUIRE(encode(half, 1.0f) == 0x3C00);
+        REQUIRE(encode(half, -2.0f) == 0xC000);
+        REQUIRE(round_trip(half, 1.0f / (1 << 24)) == 1.0f / (1 << 24));
+        REQUIRE(round_trip(half, 1.0f + 1.0f / 2048) == 1.0f);
+        REQUIRE(std::isnan(round_trip(half, std::numeric_limits<float>::quiet_NaN())));
+    }
+    SECTION("int8")
+    {
+        const Vector<float, 2> observations[] = {{-1.0f, 5.0f}, {3.0f, 5.0f}};
+        codec::Int8<2> int8;
+        int8.fit(observations, 2);
+
+        codec::Int8<2>::Code codes[2];
+        Vector<float, 2> decoded;
+        const Vector<float, 2> cases[] = {{-1.0f, 5.0f}, {3.0f, 5.0f}, {10.0f, 5.0f}};
+        const Vector<float, 2> expected[] = {{-1.0f, 5.0f}, {3.0f, 5.0f}, {3.0f, 5.0f}};
+        for (size_t i = 0; i < 3; ++i)
+        {
+            int8.encode(cases[i], codes);
+            int8.decode(codes, decoded);
+            REQUIRE(decoded == expected[i]);
+        }
+        int8.encode(Vector<float, 2>{0.3f, 5.0f}, codes);
+        int8.decode(codes, decoded);
+        REQUIRE(std::abs(decoded[0] - 0.3f) <= 4.0f / 254);
+    }
+}
+
+TEST_CASE("kMeansCompressed", "[kMeansCompressed]")
+{
+    const size_t k = 4, n = 800, max_iterations = 30;
+
+    // well-separated clusters, so that reduced precision does not change 
+    // assignments
+    std::vector<Vector4> observations;
+    fixtures::Lcg generator(23);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vector4 obs;
+        for (size_t d = 0; d < 4; ++d)
+        {
+            obs[d] = static_cast<float>(i % k) * 100.0f + 
+                     static_cast<float>(generator.next() % 1000) * 0.01f;
+        }
+        observations.push_back(obs);
+    }
+    kMeans<float, 4, distance::euclidean2<float, 4>> 
+        exhaustive(k, &observations[0], n);
+    exhaustive.initialize(&observations[0]);
+    exhaustive.run(max_iterations);
+
+    SECTION("bfloat16")
+    {
+        kMeansCompressed<codec::BFloat16, 4, distance::euclidean2<float, 4>> 
+            compressed(k, &observations[0], n);
+        compressed.initialize(&observations[0]);
+        compressed.set_thread_count(3);
+        compressed.run(max_iterations);
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(compressed.cluster(i) == exhaustive.cluster(i));
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(compressed.cluster_size(j) == exhaustive.cluster_size(j));
+            REQUIRE(std::abs(compressed.mean(j)[0] - exhaustive.mean(j)[0]) < 1.0f);
+        }
+    }
+    SECTION("int8")
+    {
+        kMeansCompressed<codec::Int8, 4, distance::manhattan<float, 4>, float> 
+            compressed(k, &observations[0], n);
+        compressed.initialize(&observations[0]);
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            if (!compressed.assign()) { break; }
+            compressed.update();
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(compressed.cluster(i) == exhaustive.cluster(i));
+            REQUIRE(std::abs(compressed.observation(i)[3] - observations[i][3]) <= 
+                    400.0f / 254);
+        }
+    }
+    SECTION("weights")
+    {
+        // integral values up to 1000 are exact in half precision
+        std::vector<Vector4> rounded(observations);
+        std::vector<float> weights;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t d = 0; d < 4; ++d) { rounded[i][d] = std::floor(rounded[i][d]); }
+            weights.push_back(static_cast<float>(generator.next() % 4));
+        }
+        kMeans<float, 4, distance::euclidean2<float, 4>>
+            weighted(k, &rounded[0], n);
+        kMeansCompressed<codec::Half, 4, distance::euclidean2<float, 4>>
+            compressed(k, &rounded[0], n);
+        weighted.initialize(&rounded[0]);
+        compressed.initialize(&rounded[0]);
+        weighted.set_weights(&weights[0]);
+        compressed.set_weights(&weights[0]);
+
+        REQUIRE(compressed.run(max_iterations) == weighted.run(max_iterations));
+        REQUIRE(compressed.inertia() == Approx(weighted.inertia()));
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(compressed.cluster_size(j) == weighted.cluster_size(j));
+            REQUIRE(compressed.mean(j)[0] == Approx(weighted.mean(j)[0]));
+        }
+    }
+    SECTION("empty clusters")
+    {
+        std::vector<Vector4> initial_means(observations.begin(), observations.begin() + k);
+        initial_means[k - 1] = Vector4(1e6f);
+        kMeansCompressed<codec::BFloat16, 4, distance::euclidean2<float, 4>>
+            compressed(k, &observations[0], n);
+        compressed.initialize(&initial_means[0]);
+
+        REQUIRE(compressed.assign());
+        REQUIRE(compressed.cluster_size(k - 1) == 0);
+        compressed.update();
+        REQUIRE(!std::isnan(compressed.mean(k - 1)[0]));
+        compressed.assign();
+        REQUIRE(compressed.cluster_size(k - 1) > 0);
+    }
+}
@@ -0,0 +1,181 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansDynamic.hpp"
+#include "fixtures.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 3> Vector3;
+
+TEST_CASE("kMeansDynamic", "[kMeansDynamic]")
+{
+    const size_t k = 5, n = 601, max_iterations = 30;
+    std::vector<Vector3> observations;
+    std::vector<float> rows;
+    fixtures::Lcg generator(11);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vector3 obs;
+        for (size_t d = 0; d < 3; ++d)
+        {
+            obs[d] = static_cast<float>(generator.next() % 1000) * 0.37f;
+            rows.push_back(obs[d]);
+        }
+        observations.push_back(obs);
+    }
+
+    SECTION("dispatched dimension")
+    {
+        kMeans<float, 3, distance::euclidean2<float, 3>> 
+            fixed(k, &observations[0], n);
+        kMeansDynamic<float, distance::euclidean2<float>> 
+            dynamic(k, 3, &rows[0], n, borrow);
+        fixed.initialize(&observations[0]);
+        dynamic.initialize(&rows[0]);
+
+        REQUIRE(dynamic.dimension() == 3);
+        REQUIRE(dynamic.run(max_iterations) == fixed.run(max_iterations));
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(dynamic.cluster(i) == fixed.cluster(i));
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(dynamic.cluster_size(j) == fixed.cluster_size(j));
+            for (size_t d = 0; d < 3; ++d)
+            {
+                REQUIRE(dynamic.mean(j)[d] == fixed.mean(j)[d]);
+            }
+        }
+    }
+    SECTION("run-time dimension")
+    {
+        // rows of three read as rows of five
+        const size_t n5 = rows.size() / 5;
+        std::vector<Vector<float, 5>> observations5(n5);
+        for (size_t i = 0; i < n5; ++i)
+        {
+            for (size_t d = 0; d < 5; ++d)
+            {
+                observations5[i][d] = rows[i * 5 + d];
+            }
+        }
+        kMeans<float, 5, distance::manhattan<float, 5>> 
+            fixed(k, &observations5[0], n5);
+        kMeansDynamic<float, distance::manhattan<float>> 
+            dynamic(k, 5, std::vector<float>(rows.begin(), rows.begin() + n5 * 5));
+        fixed.initialize(&observations5[0]);
+        dynamic.initialize(&rows[0]);
+        dynamic.set_thread_count(3);
+
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            const bool is_changed = fixed.assign();
+            REQUIRE(dynamic.assign() == is_changed);
+            for (size_t i = 0; i < n5; ++i)
+            {
+                REQUIRE(dynamic.cluster(i) == fixed.cluster(i));
+            }
+            if (!is_changed) { break; }
+            fixed.update();
+            dynamic.update();
+        }
+    }
+    SECTION("wide dimension")
+    {
+        // rows of three read as rows of sixteen, in double precision, 
+        // which has a kernel for the dimension
+        const size_t n16 = rows.size() / 16;
+        std::vector<Vector<double, 16>> observations16(n16);
+        std::vector<double> rows16;
+        for (size_t i = 0; i < n16; ++i)
+        {
+            for (size_t d = 0; d < 16; ++d)
+            {
+                observations16[i][d] = rows[i * 16 + d];
+                rows16.push_back(rows[i * 16 + d]);
+            }
+        }
+        kMeans<double, 16, distance::euclidean2<double, 16>> 
+            fixed(k, &observations16[0], n16);
+        kMeansDynamic<double, distance::euclidean2<double>> 
+            dynamic(k, 16, &rows16[0], n16, borrow);
+        fixed.initialize(&observations16[0]);
+        dynamic.initialize(&rows16[0]);
+
+        REQUIRE(dynamic.run(max_iterations) == fixed.run(max_iterations));
+        for (size_t i = 0; i < n16; ++i)
+        {
+            REQUIRE(dynamic.cluster(i) == fixed.cluster(i));
+        }
+        REQUIRE(dynamic.inertia() == Approx(fixed.inertia()));
+    }
+    SECTION("weights and tolerances")
+    {
+        std::vector<float> weights;
+        for (size_t i = 0; i < n; ++i)
+        {
+            weights.push_back(static_cast<float>(generator.next() % 4));
+        }
+        kMeans<float, 3, distance::euclidean2<float, 3>>
+            fixed(k, &observations[0], n);
+        kMeansDynamic<float, distance::euclidean2<float>>
+            dynamic(k, 3, &rows[0], n);
+        fixed.initialize(&observations[0]);
+        dynamic.initialize(&rows[0]);
+        fixed.set_weights(&weights[0]);
+        dynamic.set_weights(&weights[0]);
+        fixed.set_inertia_tolerance(0.01f);
+        dynamic.set_inertia_tolerance(0.01f);
+
+        REQUIRE(dynamic.run(max_iterations) == fixed.run(max_iterations));
+        REQUIRE(dynamic.inertia() == fixed.inertia());
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(dynamic.cluster_size(j) == fixed.cluster_size(j));
+            for (size_t d = 0; d < 3; ++d)
+            {
+                REQUIRE(dynamic.mean(j)[d] == fixed.mean(j)[d]);
+            }
+        }
+    }
+    SECTION("empty clusters")
+    {
+        // the last two means start far from every observation
+        std::vector<float> initial_means(rows.begin(), rows.begin() + k * 3);
+        std::fill(initial_means.end() - 6, initial_means.end(), 1e6f);
+        kMeansDynamic<float, distance::euclidean2<float>>
+            dynamic(k, 3, &rows[0], n);
+        dynamic.initialize(&initial_means[0]);
+
+        REQUIRE(dynamic.assign());
+        REQUIRE(dynamic.cluster_size(k - 1) == 0);
+        dynamic.update();
+        // NaN compares unequal to itself
+        for (size_t j = 0; j < k; ++j)
+        {
+            for (size_t d = 0; d < 3; ++d)
+            {
+                REQUIRE(dynamic.mean(j)[d] == dynamic.mean(j)[d]);
+            }
+        }
+        dynamic.assign();
+        REQUIRE(dynamic.cluster_size(k - 2) > 0);
+        REQUIRE(dynamic.cluster_size(k - 1) > 0);
+    }
+    SECTION("invalid dimension")
+    {
+        typedef kMeansDynamic<float, distance::euclidean2<float>> Solver;
+        REQUIRE_THROWS_AS(Solver(k, 0, &rows[0], n), const std::invalid_argument&);
+        REQUIRE_THROWS_AS(Solver(k, 4, std::vector<float>(rows.begin(), rows.begin() + 6)), 
+                          const std::invalid_argument&);
+        Solver solver(k, 3, &rows[0], n);
+        REQUIRE(solver.observation(n - 1)[2] == rows.back());
+        REQUIRE_THROWS_AS(solver.observation(n), const std::out_of_range&);
+    }
+}
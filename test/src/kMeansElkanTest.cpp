@@ -0,0 +1,12 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansElkan.hpp"
+#include "checks.hpp"
+
+
+using namespace cluster;
+
+
+TEST_CASE("kMeansElkan", "[kMeansElkan]")
+{
+    checks::require_exhaustive_results<kMeansElkan>(8);
+}
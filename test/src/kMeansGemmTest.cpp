@@ -0,0 +1,84 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansGemm.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+
+using namespace cluster;
+
+
+namespace
+{
+    // clustered data, so no observation is nearly equidistant from two means
+    template<size_t D>
+    std::vector<Vector<float, D>> clustered_observations(const size_t n, const size_t k)
+    {
+        std::vector<Vector<float, D>> centers(k), observations(n);
+        fixtures::Lcg generator(17);
+        for (size_t j = 0; j < k; ++j)
+        {
+            for (size_t d = 0; d < D; ++d)
+            {
+                centers[j][d] = static_cast<float>(generator.next() % 1000) * 0.1f;
+            }
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t d = 0; d < D; ++d)
+            {
+                observations[i][d] = centers[i % k][d] + 
+                                     static_cast<float>(generator.next() % 100) * 0.01f;
+            }
+        }
+        return observations;
+    }
+}
+
+TEST_CASE("kMeansGemm", "[kMeansGemm]")
+{
+    const size_t max_iterations = 20;
+
+    SECTION("single depth slice")
+    {
+        const size_t k = 21, n = 999;
+        const std::vector<Vector<float, 64>> observations = 
+            clustered_observations<64>(n, k);
+        kMeans<float, 64, distance::euclidean2<float, 64>> 
+            exhaustive(k, &observations[0], n);
+        kMeansGemm<float, 64, distance::euclidean2<float, 64>> 
+            gemm(k, &observations[0], n, borrow);
+        exhaustive.initialize(&observations[0]);
+        gemm.initialize(&observations[0]);
+        gemm.set_thread_count(3);
+
+        REQUIRE(gemm.run(max_iterations) == exhaustive.run(max_iterations));
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(gemm.cluster(i) == exhaustive.cluster(i));
+            // cached by kMeansGemm, computed on demand by kMeans
+            REQUIRE(gemm.observation_norm(i) == exhaustive.observation_norm(i));
+        }
+        REQUIRE(gemm.inertia() == Approx(exhaustive.inertia()));
+    }
+    SECTION("several depth slices")
+    {
+        const size_t k = 5, n = 203;
+        const std::vector<Vector<float, 300>> observations = 
+            clustered_observations<300>(n, k);
+        kMeans<float, 300, distance::euclidean2<float, 300>> 
+            exhaustive(k, &observations[0], n);
+        kMeansGemm<float, 300, distance::euclidean2<float, 300>> 
+            gemm(k, &observations[0], n);
+        exhaustive.initialize(&observations[1]);
+        gemm.initialize(&observations[1]);
+
+        REQUIRE(gemm.run(max_iterations) == exhaustive.run(max_iterations));
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(gemm.cluster(i) == exhaustive.cluster(i));
+            REQUIRE(gemm.distance(i) == exhaustive.distance(i));
+        }
+        REQUIRE(gemm.inertia() == exhaustive.inertia());
+    }
+}
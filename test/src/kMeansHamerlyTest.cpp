@@ -0,0 +1,12 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansHamerly.hpp"
+#include "checks.hpp"
+
+
+using namespace cluster;
+
+
+TEST_CASE("kMeansHamerly", "[kMeansHamerly]")
+{
+    checks::require_exhaustive_results<kMeansHamerly>(8);
+}
@@ -0,0 +1,97 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansKdTree.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 2> Vector2;
+
+TEST_CASE("kMeansKdTree", "[kMeansKdTree]")
+{
+    const size_t k = 10, n = 3000, max_iterations = 30;
+    const std::vector<Vector2> observations = fixtures::square_observations(n, 7);
+    kMeans<float, 2, distance::euclidean2<float, 2>> exhaustive(k, &observations[0], n);
+    kMeansKdTree<float, 2, distance::euclidean2<float, 2>> tree(k, &observations[0], n);
+    exhaustive.initialize(&observations[0]);
+    tree.initialize(&observations[0]);
+
+    SECTION("serial")
+    {
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            const bool is_changed = exhaustive.assign();
+            REQUIRE(tree.assign() == is_changed);
+            for (size_t i = 0; i < n; ++i)
+            {
+                REQUIRE(tree.cluster(i) == exhaustive.cluster(i));
+            }
+            for (size_t j = 0; j < k; ++j)
+            {
+                REQUIRE(tree.cluster_size(j) == exhaustive.cluster_size(j));
+            }
+            REQUIRE(tree.inertia() == Approx(exhaustive.inertia()));
+            if (!is_changed) { break; }
+
+            exhaustive.update();
+            tree.update();
+            for (size_t j = 0; j < k; ++j)
+            {
+                // integral coordinates sum exactly in any order
+                REQUIRE(tree.mean(j) == exhaustive.mean(j));
+            }
+        }
+    }
+    SECTION("weighted")
+    {
+        std::vector<float> weights(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            weights[i] = static_cast<float>(1 + i % 3);
+        }
+        exhaustive.set_weights(&weights[0]);
+        tree.set_weights(&weights[0]);
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            const bool is_changed = exhaustive.iterate();
+            REQUIRE(tree.iterate() == is_changed);
+            for (size_t j = 0; j < k; ++j)
+            {
+                REQUIRE(tree.cluster_size(j) == exhaustive.cluster_size(j));
+                REQUIRE(tree.mean(j) == exhaustive.mean(j));
+            }
+            REQUIRE(tree.inertia() == Approx(exhaustive.inertia()));
+            if (!is_changed) { break; }
+        }
+    }
+    SECTION("empty clusters")
+    {
+        // the last mean starts far from every observation, and is repaired
+        // by exact distances, not by the bounds of the tree
+        std::vector<Vector2> initial_means(observations.begin(), observations.begin() + k);
+        initial_means[k - 1] = Vector2{1e4f, 1e4f};
+        exhaustive.initialize(&initial_means[0]);
+        tree.initialize(&initial_means[0]);
+
+        REQUIRE(tree.assign() == exhaustive.assign());
+        REQUIRE(tree.cluster_size(k - 1) == 0);
+        exhaustive.update();
+        tree.update();
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(tree.mean(j) == exhaustive.mean(j));
+        }
+    }
+    SECTION("parallel")
+    {
+        tree.set_thread_count(4);
+        REQUIRE(tree.run(max_iterations) == exhaustive.run(max_iterations));
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(tree.cluster(i) == exhaustive.cluster(i));
+        }
+    }
+}
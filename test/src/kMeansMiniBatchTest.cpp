@@ -0,0 +1,94 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansMiniBatch.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 2> Vector2;
+
+TEST_CASE("kMeansMiniBatch", "[kMeansMiniBatch]")
+{
+    const size_t k = 3, n = 3000;
+    const Vector2 centers[k]
+    {
+        Vector2{0.0f, 0.0f},
+        Vector2{100.0f, 0.0f},
+        Vector2{0.0f, 100.0f}
+    };
+    std::vector<Vector2> observations;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector2 offset
+        {
+            static_cast<float>(i % 11) - 5.0f,
+            static_cast<float>(i % 7) - 3.0f
+        };
+        observations.push_back(centers[i % k] + offset);
+    }
+    kMeansMiniBatch
+    <
+        float, 2, 
+        distance::euclidean2<float, 2>
+    > 
+        solver(k, &observations[0], n);
+    // seed well away from the centers, so that the steps have to find them
+    const Vector2 initial_means[k]
+    {
+        Vector2{30.0f, 30.0f},
+        Vector2{70.0f, -20.0f},
+        Vector2{-20.0f, 70.0f}
+    };
+    solver.initialize(&initial_means[0]);
+    solver.set_batch_size(64);
+    solver.set_thread_count(2);
+
+    REQUIRE(solver.batch_size() == 64);
+    REQUIRE(solver.step_count() == 0);
+
+    solver.step();
+    const float first_shift = solver.mean_shift();
+    REQUIRE(first_shift > 0.0f);
+    solver.run_steps(49);
+    REQUIRE(solver.step_count() == 50);
+    // the shift is per step, and late steps barely move the means
+    REQUIRE(solver.mean_shift() < first_shift);
+
+    solver.assign();
+    for (size_t j = 0; j < k; ++j)
+    {
+        const Vector2& mean = solver.mean(j);
+        REQUIRE(std::abs(mean[0] - centers[j][0]) < 2.0f);
+        REQUIRE(std::abs(mean[1] - centers[j][1]) < 2.0f);
+        REQUIRE(solver.cluster_size(j) == n / k);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        REQUIRE(solver.cluster(i) == i % k);
+    }
+
+    solver.initialize(&initial_means[0]);
+    REQUIRE(solver.step_count() == 0);
+}
+
+TEST_CASE("kMeansMiniBatch: no observations", "[kMeansMiniBatch]")
+{
+    const std::vector<Vector2> observations;
+    kMeansMiniBatch
+    <
+        float, 2, 
+        distance::euclidean2<float, 2>
+    > 
+        solver(1, observations.data(), observations.size());
+    const Vector2 initial_mean{1.0f, 2.0f};
+    solver.initialize(&initial_mean);
+    solver.set_thread_count(2);
+
+    solver.run_steps(3);
+    REQUIRE(solver.step_count() == 3);
+    REQUIRE(solver.mean(0) == initial_mean);
+    REQUIRE(solver.mean_shift() == 0.0f);
+}
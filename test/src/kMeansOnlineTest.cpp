@@ -0,0 +1,85 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansOnline.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 1> Vector1;
+
+TEST_CASE("kMeansOnline", "[kMeansOnline]")
+{
+    const size_t k = 2, n = 4;
+    const Vector1 observations[n] 
+    {
+        Vector1{1.0f},
+        Vector1{2.0f},
+
+        Vector1{8.0f},
+        Vector1{9.0f}
+    };
+    kMeansOnline
+    <
+        float, 1, 
+        distance::euclidean2<float, 1>
+    > 
+        solver(k);
+
+    REQUIRE(solver.k() == k);
+    REQUIRE(solver.n() == 0);
+    REQUIRE_FALSE(solver.is_initialized());
+
+    typedef kMeansOnline<float, 1, distance::euclidean2<float, 1>> Solver;
+    REQUIRE_THROWS_AS(Solver(0), const std::invalid_argument&);
+
+    SECTION("initialized")
+    {
+        const Vector1 initial_means[k]
+        {
+            Vector1{ 4.5f },
+            Vector1{ 5.5f }
+        };
+        solver.initialize(&initial_means[0]);
+        REQUIRE(solver.is_initialized());
+
+        // the seed weighs as one observation, so the first one moves it halfway
+        REQUIRE(solver.observe(observations[0]) == 0);
+        REQUIRE(solver.mean(0) == Vector1{2.75f});
+        
+        solver.observe(&observations[1], &observations[n]);
+        REQUIRE(solver.n() == n);
+        REQUIRE(solver.mean(0)[0] == Approx(2.5f));
+        REQUIRE(solver.mean(1)[0] == Approx(7.5f));
+        REQUIRE(solver.cluster_size(0) == 3);
+        REQUIRE(solver.cluster_size(1) == 3);
+
+        solver.initialize(&initial_means[0]);
+        REQUIRE(solver.n() == 0);
+        REQUIRE(solver.mean(0) == initial_means[0]);
+        REQUIRE(solver.cluster_size(0) == 1);
+    }
+    SECTION("self-initialized")
+    {
+        const Vector1 stream[n] 
+        {
+            Vector1{1.0f},
+            Vector1{9.0f},
+
+            Vector1{2.0f},
+            Vector1{8.0f}
+        };
+        REQUIRE(solver.observe(stream[0]) == 0);
+        REQUIRE_FALSE(solver.is_initialized());
+        REQUIRE(solver.observe(stream[1]) == 1);
+        REQUIRE(solver.is_initialized());
+        REQUIRE(solver.mean(0) == stream[0]);
+        REQUIRE(solver.mean(1) == stream[1]);
+
+        solver.observe(&stream[2], &stream[n]);
+        REQUIRE(solver.mean(0) == Vector1{1.5f});
+        REQUIRE(solver.mean(1) == Vector1{8.5f});
+    }
+}
@@ -0,0 +1,120 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansRestarts.hpp"
+#include "../../core/include/random.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 2> Vector2;
+
+TEST_CASE("kMeansRestarts", "[kMeansRestarts]")
+{
+    const size_t k = 3, n = 3000;
+    const Vector2 centers[k]
+    {
+        Vector2{0.0f, 0.0f},
+        Vector2{100.0f, 0.0f},
+        Vector2{0.0f, 100.0f}
+    };
+    std::vector<Vector2> observations;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector2 offset
+        {
+            static_cast<float>(i % 11) - 5.0f,
+            static_cast<float>(i % 7) - 3.0f
+        };
+        observations.push_back(centers[i % k] + offset);
+    }
+    typedef kMeansRestarts<float, 2, distance::euclidean2<float, 2>> Restarts;
+    Restarts restarts(k, &observations[0], n);
+    restarts.set_restart_count(6);
+    restarts.set_thread_count(2);
+    restarts.set_seeder(&seeder::forgy<float, 2, const Vector2*, Vector2*>);
+
+    REQUIRE(restarts.restart_count() == 6);
+    REQUIRE(restarts.solver_thread_count() == 1);
+    REQUIRE_THROWS_AS(restarts.best(), const std::logic_error&);
+
+    SECTION("best")
+    {
+        const size_t best = restarts.run(100);
+        REQUIRE(best == restarts.best_index());
+        REQUIRE(&restarts.best().observation(0) == &observations[0]);
+        REQUIRE(restarts.best().inertia() == restarts.statistics(best).inertia);
+        for (size_t r = 0; r < restarts.restart_count(); ++r)
+        {
+            REQUIRE(restarts.statistics(r).iterations > 0);
+            REQUIRE(restarts.statistics(r).inertia >= 
+                    restarts.statistics(best).inertia);
+        }
+        // the best of several forgy restarts finds all three groups
+        for (size_t j = 0; j < k; ++j)
+        {
+            float distance = std::numeric_limits<float>::infinity();
+            for (const Vector2& center : centers)
+            {
+                distance = std::min(distance, 
+                                    distance::euclidean2<float, 2>(restarts.best().mean(j), 
+                                                                   center));
+            }
+            REQUIRE(distance < 1.0f);
+        }
+    }
+    SECTION("reproducible")
+    {
+        // solvers and seeders on two threads each, from one or three 
+        // concurrent restarts
+        restarts.set_abandon_ratio(0);
+        restarts.set_solver_thread_count(2);
+        restarts.set_parallel_seeder(&seeder::k_means_plus_plus<float, 2, const Vector2*, Vector2*>);
+        restarts.set_thread_count(3);
+        random::seed(11);
+        restarts.run(100);
+        std::vector<double> inertias;
+        for (size_t r = 0; r < restarts.restart_count(); ++r)
+        {
+            REQUIRE(!restarts.statistics(r).is_abandoned);
+            inertias.push_back(restarts.statistics(r).inertia);
+        }
+        restarts.set_thread_count(1);
+        random::seed(11);
+        restarts.run(100);
+        for (size_t r = 0; r < restarts.restart_count(); ++r)
+        {
+            REQUIRE(restarts.statistics(r).inertia == inertias[r]);
+        }
+    }
+    SECTION("no iterations")
+    {
+        // restarts are still ranked, by the inertia of their seeds
+        random::seed(11);
+        const size_t best = restarts.run(0);
+        REQUIRE(restarts.best().inertia() == restarts.statistics(best).inertia);
+        for (size_t r = 0; r < restarts.restart_count(); ++r)
+        {
+            REQUIRE(restarts.statistics(r).iterations == 0);
+            REQUIRE(restarts.statistics(r).inertia > 0);
+            REQUIRE(restarts.statistics(r).inertia >= 
+                    restarts.statistics(best).inertia);
+        }
+    }
+    SECTION("configuration")
+    {
+        restarts.set_configuration
+        (
+            [](kMeans<float, 2, distance::euclidean2<float, 2>>& solver) { solver.set_reassignment_tolerance(1.0f); }
+        );
+        restarts.run(100);
+        for (size_t r = 0; r < restarts.restart_count(); ++r)
+        {
+            REQUIRE(restarts.statistics(r).iterations == 1);
+        }
+    }
+}
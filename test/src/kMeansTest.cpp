@@ -4,6 +4,8 @@
 #include "../../core/include/kmeans.hpp"
 
 #include <array>
+#include <stdexcept>
+#include <vector>
 
 
 using namespace cluster;
@@ -101,3 +103,329 @@ TEST_CASE("kMeans", "[kMeans]")
         REQUIRE(solver.mean(cluster_b) == expected_means[cluster_b]);
     }
 }
+
+typedef Vector<float, 2> Vector2;
+
+TEST_CASE("kMeans: parallel assign and update", "[kMeans][kMeans-parallel]")
+{
+    const size_t k = 5, n = 1000;
+    std::vector<Vector2> observations;
+    for (size_t i = 0; i < n; ++i)
+    {
+        observations.push_back(Vector2
+        {
+            static_cast<float>((i * 7) % 101),
+            static_cast<float>((i * 13) % 97)
+        });
+    }
+    typedef kMeans<float, 2, distance::euclidean2<float, 2>> Solver;
+    Solver serial(k, &observations[0], n),
+           parallel(k, &observations[0], n);
+    serial.initialize(&observations[0]);
+    parallel.initialize(&observations[0]);
+    parallel.set_thread_count(4);
+
+    REQUIRE(serial.thread_count() == 1);
+    REQUIRE(parallel.thread_count() == 4);
+
+    for (size_t iteration = 0; iteration < 3; ++iteration)
+    {
+        REQUIRE(parallel.assign() == serial.assign());
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(parallel.cluster(i) == serial.cluster(i));
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(parallel.cluster_size(j) == serial.cluster_size(j));
+        }
+        serial.update();
+        parallel.update();
+        for (size_t j = 0; j < k; ++j)
+        {
+            // integral coordinates sum exactly in any order
+            REQUIRE(parallel.mean(j) == serial.mean(j));
+        }
+    }
+}
+
+TEST_CASE("kMeans: fused iteration", "[kMeans][kMeans-iterate]")
+{
+    const size_t k = 5, n = 1000;
+    std::vector<Vector2> observations;
+    for (size_t i = 0; i < n; ++i)
+    {
+        observations.push_back(Vector2
+        {
+            static_cast<float>((i * 7) % 101),
+            static_cast<float>((i * 13) % 97)
+        });
+    }
+    typedef kMeans<float, 2, distance::euclidean2<float, 2>> Solver;
+    Solver separate(k, &observations[0], n),
+           fused(k, &observations[0], n);
+    separate.initialize(&observations[0]);
+    fused.initialize(&observations[0]);
+    fused.set_thread_count(3);
+
+    bool is_changed = true;
+    while (is_changed)
+    {
+        is_changed = separate.assign();
+        if (is_changed) { separate.update(); }
+        
+        REQUIRE(fused.iterate() == is_changed);
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(fused.cluster(i) == separate.cluster(i));
+        }
+        for (size_t j = 0; j < k; ++j)
+        {
+            REQUIRE(fused.cluster_size(j) == separate.cluster_size(j));
+            REQUIRE(fused.mean(j) == separate.mean(j));
+        }
+    }
+}
+
+TEST_CASE("kMeans: observation storage", "[kMeans][kMeans-storage]")
+{
+    const size_t k = 2, n = 4;
+    std::vector<Vector1> observations
+    {
+        Vector1{1.0f},
+        Vector1{2.0f},
+
+        Vector1{8.0f},
+        Vector1{9.0f}
+    };
+    const Vector1 initial_means[k]
+    {
+        Vector1{ 4.5f },
+        Vector1{ 5.5f }
+    };
+    typedef kMeans<float, 1, distance::euclidean2<float, 1>> Solver;
+
+    SECTION("borrowed")
+    {
+        Solver solver(k, &observations[0], n, borrow);
+        REQUIRE(solver.n() == n);
+        REQUIRE(&solver.observation(0) == &observations[0]);
+
+        solver.initialize(&initial_means[0]);
+        REQUIRE(solver.run(2) == 1);
+        REQUIRE(solver.mean(solver.cluster(0)) == Vector1{1.5f});
+        REQUIRE(solver.mean(solver.cluster(3)) == Vector1{8.5f});
+    }
+    SECTION("adopted")
+    {
+        const Vector1* storage = &observations[0];
+        Solver solver(k, std::move(observations));
+        REQUIRE(solver.n() == n);
+        REQUIRE(&solver.observation(0) == storage);
+
+        solver.initialize(&initial_means[0]);
+        REQUIRE(solver.run(2) == 1);
+        REQUIRE(solver.mean(solver.cluster(0)) == Vector1{1.5f});
+        REQUIRE(solver.mean(solver.cluster(3)) == Vector1{8.5f});
+
+        const Solver copy(solver);
+        REQUIRE(copy.observation(3) == Vector1{9.0f});
+        REQUIRE(&copy.observation(0) != storage);
+    }
+    SECTION("out of range")
+    {
+        const Solver solver(k, &observations[0], n, borrow);
+        REQUIRE_THROWS_AS(solver.observation(n), const std::out_of_range&);
+    }
+}
+
+TEST_CASE("kMeans: weights", "[kMeans][kMeans-weights]")
+{
+    const size_t k = 2, n = 4;
+    const Vector1 observations[n]
+    {
+        Vector1{1.0f},
+        Vector1{2.0f},
+
+        Vector1{8.0f},
+        Vector1{9.0f}
+    };
+    const float weights[n] { 1.0f, 3.0f, 1.0f, 1.0f };
+    const Vector1 initial_means[k]
+    {
+        Vector1{ 4.5f },
+        Vector1{ 5.5f }
+    };
+    kMeans<float, 1, distance::euclidean2<float, 1>> solver(k, observations, n);
+    REQUIRE(!solver.is_weighted());
+    REQUIRE(solver.weight(1) == 1.0f);
+
+    solver.set_weights(weights);
+    REQUIRE(solver.is_weighted());
+    REQUIRE(solver.weight(1) == 3.0f);
+
+    SECTION("fused")
+    {
+        solver.initialize(initial_means);
+        REQUIRE(solver.run(5) == 1);
+    }
+    SECTION("separate")
+    {
+        solver.set_thread_count(2);
+        solver.initialize(initial_means);
+        REQUIRE(solver.assign());
+        solver.update();
+    }
+    const size_t cluster_a = solver.cluster(0),
+                 cluster_b = solver.cluster(3);
+    REQUIRE(solver.cluster_size(cluster_a) == 4);
+    REQUIRE(solver.cluster_size(cluster_b) == 2);
+    REQUIRE(solver.mean(cluster_a) == Vector1{1.75f});
+    REQUIRE(solver.mean(cluster_b) == Vector1{8.5f});
+
+    solver.set_weights(nullptr);
+    REQUIRE(!solver.is_weighted());
+    solver.assign();
+    solver.update();
+    REQUIRE(solver.cluster_size(cluster_a) == 2);
+    REQUIRE(solver.mean(cluster_a) == Vector1{1.5f});
+}
+
+TEST_CASE("kMeans: tolerances", "[kMeans][kMeans-tolerances]")
+{
+    typedef kMeans<float, 1, distance::euclidean2<float, 1>> Solver;
+    SECTION("statistics")
+    {
+        const size_t k = 2, n = 4;
+        const Vector1 observations[n]
+        {
+            Vector1{1.0f},
+            Vector1{2.0f},
+
+            Vector1{8.0f},
+            Vector1{9.0f}
+        };
+        const Vector1 initial_means[k]
+        {
+            Vector1{ 4.5f },
+            Vector1{ 5.5f }
+        };
+        Solver solver(k, observations, n);
+        solver.initialize(initial_means);
+
+        REQUIRE(solver.assign());
+        REQUIRE(solver.reassigned_count() == 2);
+        REQUIRE(solver.distance(0) == 12.25f);
+        REQUIRE(solver.distance(2) == 6.25f);
+        REQUIRE(solver.inertia() == 37);
+        REQUIRE(solver.mean_shift() == 0);
+
+        solver.update();
+        REQUIRE(solver.mean_shift() == 9);
+        REQUIRE(!solver.iterate());
+        REQUIRE(solver.reassigned_count() == 0);
+        REQUIRE(solver.inertia() == 1);
+    }
+    SECTION("termination")
+    {
+        const size_t k = 5, n = 1000, max_iterations = 100;
+        std::vector<Vector1> observations;
+        for (size_t i = 0; i < n; ++i)
+        {
+            observations.push_back(Vector1{static_cast<float>((i * 7) % 101)});
+        }
+        Solver exact(k, &observations[0], n),
+               shifting(k, &observations[0], n),
+               reassigning(k, &observations[0], n),
+               improving(k, &observations[0], n);
+        exact.initialize(&observations[0]);
+        shifting.initialize(&observations[0]);
+        reassigning.initialize(&observations[0]);
+        improving.initialize(&observations[0]);
+        REQUIRE(exact.run(max_iterations) > 2);
+
+        shifting.set_shift_tolerance(1e9f);
+        REQUIRE(shifting.run(max_iterations) == 1);
+
+        reassigning.set_reassignment_tolerance(1.0f);
+        REQUIRE(reassigning.run(max_iterations) == 1);
+
+        improving.set_inertia_tolerance(1.0f);
+        REQUIRE(improving.run(max_iterations) == 2);
+    }
+}
+
+TEST_CASE("kMeans: empty clusters", "[kMeans][kMeans-empty]")
+{
+    const size_t k = 3, n = 5;
+    const Vector1 observations[n]
+    {
+        Vector1{0.0f},
+        Vector1{1.0f},
+        Vector1{2.5f},
+
+        Vector1{8.0f},
+        Vector1{11.0f}
+    };
+    const Vector1 initial_means[k]
+    {
+        Vector1{ 1.5f },
+        Vector1{ 9.0f },
+        Vector1{ 100.0f }
+    };
+    kMeans<float, 1, distance::euclidean2<float, 1>> solver(k, observations, n);
+    solver.initialize(initial_means);
+
+    SECTION("keep")
+    {
+        solver.set_empty_cluster_policy(EmptyClusterPolicy::keep);
+        REQUIRE(solver.iterate());
+        REQUIRE(solver.cluster_size(2) == 0);
+        REQUIRE(solver.mean(2) == initial_means[2]);
+    }
+    SECTION("farthest")
+    {
+        REQUIRE(solver.iterate());
+        REQUIRE(solver.mean(2) == observations[4]);
+        
+        REQUIRE(solver.iterate());
+        REQUIRE(solver.cluster(4) == 2);
+        REQUIRE(solver.cluster_size(2) == 1);
+    }
+    SECTION("split largest")
+    {
+        solver.set_empty_cluster_policy(EmptyClusterPolicy::split_largest);
+        REQUIRE(solver.assign());
+        solver.update();
+        REQUIRE(solver.mean(1) == Vector1{9.5f});
+        REQUIRE(solver.mean(2) == observations[0]);
+    }
+}
+
+TEST_CASE("kMeans: cached norms", "[kMeans][kMeans-norms]")
+{
+    const size_t k = 2, n = 4;
+    const Vector2 observations[n]
+    {
+        Vector2{0.0f, 1.0f},
+        Vector2{1.0f, 1.0f},
+
+        Vector2{3.0f, 4.0f},
+        Vector2{5.0f, 4.0f}
+    };
+    kMeans<float, 2, distance::euclidean2<float, 2>> solver(k, observations, n);
+    REQUIRE(solver.observation_norm(0) == 1);
+    REQUIRE(solver.observation_norm(2) == 25);
+
+    solver.initialize(&observations[1]);
+    REQUIRE(solver.mean_norm(0) == 2);
+    REQUIRE(solver.mean_norm(1) == 25);
+
+    REQUIRE(solver.iterate());
+    for (size_t j = 0; j < k; ++j)
+    {
+        const Vector2& mean = solver.mean(j);
+        REQUIRE(solver.mean_norm(j) == mean[0] * mean[0] + mean[1] * mean[1]);
+    }
+    REQUIRE(solver.mean_norm(solver.cluster(3)) == 32);
+}
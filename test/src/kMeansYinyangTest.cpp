@@ -0,0 +1,44 @@
+#include "../lib/catch.hpp"
+#include "../../core/include/kMeansYinyang.hpp"
+#include "checks.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+
+using namespace cluster;
+
+
+typedef Vector<float, 2> Vector2;
+
+namespace
+{
+    struct FourGroups
+    {
+        template<typename Solver>
+        void operator()(Solver& solver) const { solver.set_group_count(4); }
+    };
+}
+
+TEST_CASE("kMeansYinyang", "[kMeansYinyang]")
+{
+    checks::require_exhaustive_results<kMeansYinyang>(40, FourGroups());
+}
+
+TEST_CASE("kMeansYinyang: groups", "[kMeansYinyang]")
+{
+    const size_t k = 40, n = 2000, max_iterations = 30;
+    const std::vector<Vector2> observations = fixtures::square_observations(n, 1);
+
+    kMeansYinyang<float, 2, distance::euclidean2<float, 2>> yinyang(k, &observations[0], n, 
+                                                                    borrow);
+    yinyang.set_group_count(4);
+    yinyang.initialize(&observations[0]);
+    REQUIRE(yinyang.group_count() == 4);
+
+    yinyang.run(max_iterations);
+    for (size_t j = 0; j < k; ++j)
+    {
+        REQUIRE(yinyang.group(j) < yinyang.group_count());
+    }
+}